@@ -26,21 +26,13 @@ Bishop::~Bishop()
 
 }
 
-// @purpose: Calculate all possible moves given a character representation of the boad
-// @parameters: Character Representation of the board, Color of piece that is moving
+// @purpose: Calculate all possible moves of this piece
+// @parameters: Board object to search, Move list to add the moves to
 // @return: None
-void Bishop::calculateMoves(Board* board, Colors turn)
+void Bishop::calculateMoves(Board* board, MoveList& moveList)
 {
-    // Clear the current move vector
-    moves.clear();
-    protecting.clear();
-
     // Calculate moves in all possible directions
-    calculateSlidingMoves(board, UP_LEFT);
-    calculateSlidingMoves(board, UP_RIGHT);
-    calculateSlidingMoves(board, DN_LEFT);
-    calculateSlidingMoves(board, DN_RIGHT);
-
+    calculateSlidingMoves(board, moveList);
 }
 
 
@@ -0,0 +1,266 @@
+//-------------------------------------------------------
+//
+// File: Bitboard.cpp
+// Author: Edward Koch
+// Description: Holds the definition of the Bitboards Class
+//
+// Revision History
+// Author    Date    Description
+//-------------------------------------------------------
+// E. Koch    10/17/26    Initial Creation of Bitboards class
+//-------------------------------------------------------
+#include "Bitboard.h"
+
+Bitboard Bitboards::KnightAttacks[Chess::NumSquares] = { 0 };
+Bitboard Bitboards::KingAttacks[Chess::NumSquares] = { 0 };
+Bitboard Bitboards::PawnAttacks[BLACK + 1][Chess::NumSquares] = { { 0 } };
+
+Bitboard Bitboards::AdjacentFiles[Chess::NumFiles] = { 0 };
+Bitboard Bitboards::ForwardFiles[BLACK + 1][Chess::NumSquares] = { { 0 } };
+Bitboard Bitboards::PassedPawnSpans[BLACK + 1][Chess::NumSquares] = { { 0 } };
+
+Bitboards::Magic Bitboards::RookMagics[Chess::NumSquares];
+Bitboards::Magic Bitboards::BishopMagics[Chess::NumSquares];
+Bitboard Bitboards::RookTable[RookTableSize] = { 0 };
+Bitboard Bitboards::BishopTable[BishopTableSize] = { 0 };
+
+Bitboard Bitboards::Between[Chess::NumSquares][Chess::NumSquares] = { { 0 } };
+
+bool Bitboards::initialized = false;
+
+// Rank and file steps of the sliding directions - Up, Down, Left, Right, then the diagonals
+static const int RookRankSteps[4] = { -1, 1, 0, 0 };
+static const int RookFileSteps[4] = { 0, 0, -1, 1 };
+static const int BishopRankSteps[4] = { -1, -1, 1, 1 };
+static const int BishopFileSteps[4] = { -1, 1, -1, 1 };
+
+// @purpose: Builds all of the precomputed attack tables - only runs once
+// @parameters: None
+// @return: None
+void Bitboards::init()
+{
+    if (initialized) return;
+
+    // Rank offsets are negative towards the 8th rank, the same as the board index
+    const int knightRanks[8] = { -2, -2, -1, -1, 1, 1, 2, 2 };
+    const int knightFiles[8] = { -1, 1, -2, 2, -2, 2, -1, 1 };
+
+    const int kingRanks[8] = { -1, -1, -1, 0, 0, 1, 1, 1 };
+    const int kingFiles[8] = { -1, 0, 1, -1, 1, -1, 0, 1 };
+
+    // White Pawns attack up the board, Black Pawns attack down the board
+    const int whitePawnRanks[2] = { -1, -1 };
+    const int blackPawnRanks[2] = { 1, 1 };
+    const int pawnFiles[2] = { -1, 1 };
+
+    for (int sq = A8; sq <= H1; ++sq)
+    {
+        KnightAttacks[sq] = leaperAttacks(sq, knightRanks, knightFiles, 8);
+        KingAttacks[sq] = leaperAttacks(sq, kingRanks, kingFiles, 8);
+        PawnAttacks[WHITE][sq] = leaperAttacks(sq, whitePawnRanks, pawnFiles, 2);
+        PawnAttacks[BLACK][sq] = leaperAttacks(sq, blackPawnRanks, pawnFiles, 2);
+    }
+
+    for (int file = 0; file < Chess::NumFiles; ++file)
+    {
+        AdjacentFiles[file] = ((file > 0) ? fileBB(file - 1) : Empty) | ((file < Chess::NumFiles - 1) ? fileBB(file + 1) : Empty);
+    }
+
+    // White Pawns move towards the 8th rank at index 0, Black Pawns move away from it
+    for (int sq = A8; sq <= H1; ++sq)
+    {
+        int file = sq % Chess::NumFiles;
+
+        for (int ahead = sq - Chess::NumFiles; ahead >= A8; ahead -= Chess::NumFiles)
+        {
+            ForwardFiles[WHITE][sq] |= squareBB(ahead);
+        }
+        for (int ahead = sq + Chess::NumFiles; ahead <= H1; ahead += Chess::NumFiles)
+        {
+            ForwardFiles[BLACK][sq] |= squareBB(ahead);
+        }
+
+        // Spread the file in front of the square onto the files next to it
+        for (int color = WHITE; color <= BLACK; ++color)
+        {
+            Bitboard forward = ForwardFiles[color][sq];
+            PassedPawnSpans[color][sq] = forward;
+            if (file > 0) PassedPawnSpans[color][sq] |= forward >> 1;
+            if (file < Chess::NumFiles - 1) PassedPawnSpans[color][sq] |= forward << 1;
+        }
+    }
+
+    // Build the sliding piece tables
+    initMagics(RookMagics, RookTable, RookRankSteps, RookFileSteps);
+    initMagics(BishopMagics, BishopTable, BishopRankSteps, BishopFileSteps);
+
+    // The squares between two aligned squares are the intersection of the attacks from both
+    for (int a = A8; a <= H1; ++a)
+    {
+        for (int b = A8; b <= H1; ++b)
+        {
+            Bitboard bothSquares = squareBB(a) | squareBB(b);
+
+            if (rookAttacks((Squares)a, Empty) & squareBB(b))
+            {
+                Between[a][b] = rookAttacks((Squares)a, bothSquares) & rookAttacks((Squares)b, bothSquares);
+            }
+            else if (bishopAttacks((Squares)a, Empty) & squareBB(b))
+            {
+                Between[a][b] = bishopAttacks((Squares)a, bothSquares) & bishopAttacks((Squares)b, bothSquares);
+            }
+        }
+    }
+
+    initialized = true;
+}
+
+// @purpose: Builds a leaper attack set from a list of rank and file offsets
+// @parameters: Starting square, rank offsets, file offsets, number of offsets
+// @return: Bitboard of attacked squares
+Bitboard Bitboards::leaperAttacks(int sq, const int* rankOffsets, const int* fileOffsets, int numOffsets)
+{
+    Bitboard attacks = Empty;
+
+    int rank = sq / Chess::NumFiles;
+    int file = sq % Chess::NumFiles;
+
+    for (int i = 0; i < numOffsets; ++i)
+    {
+        int targetRank = rank + rankOffsets[i];
+        int targetFile = file + fileOffsets[i];
+
+        // Do not add squares that are off of the board
+        if (targetRank < 0 || targetRank >= Chess::NumRanks ||
+            targetFile < 0 || targetFile >= Chess::NumFiles)
+        {
+            continue;
+        }
+
+        attacks |= squareBB(targetRank * Chess::NumFiles + targetFile);
+    }
+
+    return attacks;
+}
+
+// @purpose: Builds a slider attack set by walking each direction until blocked
+// @parameters: Starting square, occupied squares, rank and file steps of each direction, number of directions
+// @return: Bitboard of attacked squares
+Bitboard Bitboards::slidingAttacks(int sq, Bitboard occupied, const int* rankSteps, const int* fileSteps, int numDirections)
+{
+    Bitboard attacks = Empty;
+
+    for (int dir = 0; dir < numDirections; ++dir)
+    {
+        int rank = sq / Chess::NumFiles + rankSteps[dir];
+        int file = sq % Chess::NumFiles + fileSteps[dir];
+
+        // Walk until falling off of the board
+        while (rank >= 0 && rank < Chess::NumRanks &&
+               file >= 0 && file < Chess::NumFiles)
+        {
+            Bitboard target = squareBB(rank * Chess::NumFiles + file);
+            attacks |= target;
+
+            // Stop Searching in this direction after the first blocker
+            if (occupied & target)
+            {
+                break;
+            }
+
+            rank += rankSteps[dir];
+            file += fileSteps[dir];
+        }
+    }
+
+    return attacks;
+}
+
+// @purpose: Finds the magic numbers and fills the attack table for one slider
+// @parameters: Magic lookups to fill, attack table to fill, rank and file steps of each direction
+// @return: None
+void Bitboards::initMagics(Magic* magics, Bitboard* table, const int* rankSteps, const int* fileSteps)
+{
+    // Every subset of a mask has at most 4096 (2^12) entries
+    const int MaxSubsets = 4096;
+    Bitboard occupancy[MaxSubsets];
+    Bitboard reference[MaxSubsets];
+
+#if !defined(USE_PEXT)
+    int epoch[MaxSubsets] = { 0 };
+    int attempt = 0;
+
+    // Fixed seeds per rank (8th rank first) that find magics quickly, so the same magics are found every run
+    const uint64_t seeds[Chess::NumRanks] = { 728, 2985, 2409, 2501, 1289, 2821, 1699, 255 };
+#endif
+
+    for (int sq = A8; sq <= H1; ++sq)
+    {
+        Magic& m = magics[sq];
+
+        // Pieces on the edge of the board never block, unless the slider is on that edge
+        Bitboard rank = Rank8 << (Chess::NumFiles * (sq / Chess::NumFiles));
+        Bitboard file = FileA << (sq % Chess::NumFiles);
+        Bitboard edges = ((Rank8 | Rank1) & ~rank) | ((FileA | FileH) & ~file);
+
+        m.mask = slidingAttacks(sq, Empty, rankSteps, fileSteps, 4) & ~edges;
+        m.shift = 64 - popCount(m.mask);
+        m.magic = 0;
+
+        // Each square's table starts where the last one ended
+        m.attacks = (sq == A8) ? table : magics[sq - 1].attacks + (1 << (64 - magics[sq - 1].shift));
+
+        // Enumerate every subset of the mask (Carry-Rippler) with its true attacks
+        int size = 0;
+        Bitboard subset = 0;
+        do
+        {
+            occupancy[size] = subset;
+            reference[size] = slidingAttacks(sq, subset, rankSteps, fileSteps, 4);
+#if defined(USE_PEXT)
+            m.attacks[_pext_u64(subset, m.mask)] = reference[size];
+#endif
+            ++size;
+            subset = (subset - m.mask) & m.mask;
+        } while (subset);
+
+#if !defined(USE_PEXT)
+        uint64_t seed = seeds[sq / Chess::NumFiles];
+
+        // Try sparse random numbers until one maps every subset without a destructive collision
+        for (int i = 0; i < size; )
+        {
+            do
+            {
+                Bitboard candidate = ~0ULL;
+                for (int bits = 0; bits < 3; ++bits)
+                {
+                    // xorshift64* random number generator
+                    seed ^= seed >> 12;
+                    seed ^= seed << 25;
+                    seed ^= seed >> 27;
+                    candidate &= seed * 2685821657736338717ULL;
+                }
+                m.magic = candidate;
+            } while (popCount((m.mask * m.magic) >> 56) < 6);
+
+            // Use an epoch per attempt instead of clearing the table every time
+            ++attempt;
+            for (i = 0; i < size; ++i)
+            {
+                unsigned int index = m.index(occupancy[i]);
+
+                if (epoch[index] < attempt)
+                {
+                    epoch[index] = attempt;
+                    m.attacks[index] = reference[i];
+                }
+                else if (m.attacks[index] != reference[i])
+                {
+                    break;
+                }
+            }
+        }
+#endif
+    }
+}
@@ -0,0 +1,266 @@
+//-------------------------------------------------------
+//
+// File: Bitboard.h
+// Author: Edward Koch
+// Description: Holds the declaration of the Bitboards Class
+//              A Bitboard is a 64-bit set with one bit per square,
+//              bit 0 is A8 and bit 63 is H1 to match the Squares enum
+//              Sliding attacks use magic bitboards - https://www.chessprogramming.org/Magic_Bitboards
+//              Define USE_PEXT on BMI2 capable targets to index with PEXT instead of magics
+//
+// Revision History
+// Author    Date    Description
+//-------------------------------------------------------
+// E. Koch    10/17/26    Initial Creation of Bitboards class
+//-------------------------------------------------------
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include <stdint.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#if defined(USE_PEXT)
+#include <immintrin.h>
+#endif
+
+#include "ChessTypes.h"
+
+// A set of squares, one bit per square
+typedef uint64_t Bitboard;
+
+class Bitboards
+{
+public:
+    // Masks of commonly used sets of squares
+    static const Bitboard Empty = 0ULL;
+    static const Bitboard FileA = 0x0101010101010101ULL;
+    static const Bitboard FileH = 0x8080808080808080ULL;
+    static const Bitboard Rank8 = 0x00000000000000FFULL;
+    static const Bitboard Rank1 = 0xFF00000000000000ULL;
+
+    // @purpose: Builds all of the precomputed attack tables - only runs once
+    // @parameters: None
+    // @return: None
+    static void init();
+
+    // @purpose: Get the Bitboard with only one square set
+    // @parameters: Square to set
+    // @return: Bitboard of the square
+    static inline Bitboard squareBB(int sq)
+    {
+        return 1ULL << sq;
+    }
+
+    // @purpose: Counts the number of squares in a Bitboard
+    // @parameters: Bitboard to count
+    // @return: Number of set squares
+    static inline int popCount(Bitboard bb)
+    {
+#if defined(_MSC_VER) && defined(_WIN64)
+        return (int)__popcnt64(bb);
+#elif defined(__GNUC__)
+        return __builtin_popcountll(bb);
+#else
+        int count = 0;
+        for (; bb; bb &= bb - 1)
+        {
+            ++count;
+        }
+        return count;
+#endif
+    }
+
+    // @purpose: Gets the lowest square (closest to A8) of a non-empty Bitboard
+    // @parameters: Bitboard to search
+    // @return: Lowest square in the Bitboard
+    static inline Squares lsb(Bitboard bb)
+    {
+#if defined(_MSC_VER) && defined(_WIN64)
+        unsigned long index;
+        _BitScanForward64(&index, bb);
+        return (Squares)index;
+#elif defined(__GNUC__)
+        return (Squares)__builtin_ctzll(bb);
+#else
+        int index = 0;
+        while ((bb & 1ULL) == 0)
+        {
+            bb >>= 1;
+            ++index;
+        }
+        return (Squares)index;
+#endif
+    }
+
+    // @purpose: Removes and returns the lowest square of a non-empty Bitboard
+    // @parameters: Bitboard to pop from
+    // @return: Lowest square in the Bitboard
+    static inline Squares popLsb(Bitboard& bb)
+    {
+        Squares sq = lsb(bb);
+        bb &= bb - 1;
+        return sq;
+    }
+
+    // @purpose: Get the squares a Knight attacks from a square
+    // @parameters: Square of the Knight
+    // @return: Bitboard of attacked squares
+    static inline Bitboard knightAttacks(Squares sq)
+    {
+        return KnightAttacks[sq];
+    }
+
+    // @purpose: Get the squares a King attacks from a square
+    // @parameters: Square of the King
+    // @return: Bitboard of attacked squares
+    static inline Bitboard kingAttacks(Squares sq)
+    {
+        return KingAttacks[sq];
+    }
+
+    // @purpose: Get the squares a Pawn attacks from a square
+    // @parameters: Color of the Pawn, Square of the Pawn
+    // @return: Bitboard of attacked squares
+    static inline Bitboard pawnAttacks(Colors color, Squares sq)
+    {
+        return PawnAttacks[color][sq];
+    }
+
+    // @purpose: Get the squares a Rook attacks from a square
+    // @parameters: Square of the Rook, Bitboard of all occupied squares
+    // @return: Bitboard of attacked squares, including the first blocker in each direction
+    static inline Bitboard rookAttacks(Squares sq, Bitboard occupied)
+    {
+        return RookMagics[sq].attacks[RookMagics[sq].index(occupied)];
+    }
+
+    // @purpose: Get the squares a Bishop attacks from a square
+    // @parameters: Square of the Bishop, Bitboard of all occupied squares
+    // @return: Bitboard of attacked squares, including the first blocker in each direction
+    static inline Bitboard bishopAttacks(Squares sq, Bitboard occupied)
+    {
+        return BishopMagics[sq].attacks[BishopMagics[sq].index(occupied)];
+    }
+
+    // @purpose: Get the squares a Queen attacks from a square
+    // @parameters: Square of the Queen, Bitboard of all occupied squares
+    // @return: Bitboard of attacked squares, including the first blocker in each direction
+    static inline Bitboard queenAttacks(Squares sq, Bitboard occupied)
+    {
+        return rookAttacks(sq, occupied) | bishopAttacks(sq, occupied);
+    }
+
+    // @purpose: Get all of the squares of a file
+    // @parameters: File, 0 for the A file
+    // @return: Bitboard of the file
+    static inline Bitboard fileBB(int file)
+    {
+        return FileA << file;
+    }
+
+    // @purpose: Get all of the squares of the files next to a file
+    // @parameters: File, 0 for the A file
+    // @return: Bitboard of one or two files
+    static inline Bitboard adjacentFiles(int file)
+    {
+        return AdjacentFiles[file];
+    }
+
+    // @purpose: Get the squares in front of a square on its file, from the point of view of one color
+    // @parameters: Color moving up the file, Square to start from
+    // @return: Bitboard of the squares a Pawn of that color would pass on its way to promoting
+    static inline Bitboard forwardFile(Colors color, Squares sq)
+    {
+        return ForwardFiles[color][sq];
+    }
+
+    // @purpose: Get the squares that enemy Pawns must be off of for a Pawn to be passed
+    // @parameters: Color of the Pawn, Square of the Pawn
+    // @return: Bitboard of the squares in front of the Pawn on its own file and the files next to it
+    static inline Bitboard passedPawnSpan(Colors color, Squares sq)
+    {
+        return PassedPawnSpans[color][sq];
+    }
+
+    // @purpose: Get the squares strictly between two squares on a rank, file or diagonal
+    // @parameters: Two squares
+    // @return: Bitboard of the squares between, empty if the squares are not aligned
+    static inline Bitboard between(Squares a, Squares b)
+    {
+        return Between[a][b];
+    }
+
+private:
+    // Holds the lookup information for one square of a magic table
+    struct Magic
+    {
+        Bitboard mask;
+        Bitboard magic;
+        Bitboard* attacks;
+        int shift;
+
+        // @purpose: Maps the relevant occupancy to an index in the attack table
+        // @parameters: Bitboard of all occupied squares
+        // @return: Index into the attack table
+        inline unsigned int index(Bitboard occupied) const
+        {
+#if defined(USE_PEXT)
+            return (unsigned int)_pext_u64(occupied, mask);
+#else
+            return (unsigned int)(((occupied & mask) * magic) >> shift);
+#endif
+        }
+    };
+
+    // The number of entries needed for all squares of each slider
+    static const int RookTableSize = 0x19000;
+    static const int BishopTableSize = 0x1480;
+
+    // Magic lookups and the shared attack tables that they index into
+    static Magic RookMagics[Chess::NumSquares];
+    static Magic BishopMagics[Chess::NumSquares];
+    static Bitboard RookTable[RookTableSize];
+    static Bitboard BishopTable[BishopTableSize];
+
+    // Squares between any two aligned squares
+    static Bitboard Between[Chess::NumSquares][Chess::NumSquares];
+
+    // Precomputed attack tables for the non-sliding pieces
+    static Bitboard KnightAttacks[Chess::NumSquares];
+    static Bitboard KingAttacks[Chess::NumSquares];
+    static Bitboard PawnAttacks[BLACK + 1][Chess::NumSquares];
+
+    // Precomputed Pawn structure masks
+    static Bitboard AdjacentFiles[Chess::NumFiles];
+    static Bitboard ForwardFiles[BLACK + 1][Chess::NumSquares];
+    static Bitboard PassedPawnSpans[BLACK + 1][Chess::NumSquares];
+
+    // Determines if the tables have been built
+    static bool initialized;
+
+    // @purpose: Builds a leaper attack set from a list of rank and file offsets
+    // @parameters: Starting square, rank offsets, file offsets, number of offsets
+    // @return: Bitboard of attacked squares
+    static Bitboard leaperAttacks(int sq, const int* rankOffsets, const int* fileOffsets, int numOffsets);
+
+    // @purpose: Builds a slider attack set by walking each direction until blocked
+    // @parameters: Starting square, occupied squares, rank and file steps of each direction, number of directions
+    // @return: Bitboard of attacked squares
+    static Bitboard slidingAttacks(int sq, Bitboard occupied, const int* rankSteps, const int* fileSteps, int numDirections);
+
+    // @purpose: Finds the magic numbers and fills the attack table for one slider
+    // @parameters: Magic lookups to fill, attack table to fill, rank and file steps of each direction
+    // @return: None
+    static void initMagics(Magic* magics, Bitboard* table, const int* rankSteps, const int* fileSteps);
+
+    // Default Constructor
+    Bitboards();
+
+    // Default Destructor
+    ~Bitboards();
+};
+
+#endif // BITBOARD_H
@@ -9,6 +9,9 @@
 //-------------------------------------------------------
 // E. Koch    03/03/23    Initial Creation of Board class
 //-------------------------------------------------------
+#include <algorithm>
+#include <cctype>
+#include <cstring>
 #include <iostream>
 #include <vector>
 
@@ -28,31 +31,138 @@
 // @return: None
 Board::Board(const char* fenString)
     : board{ 0 },
+      pieceBB{ { 0 } },
+      colorBB{ 0 },
+      occupiedBB(0),
       charBoard(new char[Chess::NumRanks * Chess::NumFiles]),
       fen(fenString),
       gameStatus(IN_PROGRESS),
+      hashKey(0),
+      pawnKey(0),
+      materialScore{ { 0 } },
+      phase(0),
+      stateHistory(),
       moveHistory(),
       whiteMoves(),
       blackMoves(),
-      whiteProtecting(),
-      blackProtecting(),
-      whiteCheckPaths(),
-      blackCheckPaths()
+      sparePieces(),
+      protectedBB{ 0 },
+      checkersBB{ 0 },
+      checkMaskBB{ 0 },
+      movesValid{ false },
+      conditionsValid{ false },
+      statusValid(false)
 {
+    Bitboards::init();
+    Zobrist::init();
     initializeBoard();
     setCharBoard();
+
+    // Every later change to the key is made incrementally by the moves
+    hashKey = calculateHash();
     printBoardToConsole();
-    // Do initial calculations for both colors
-    calculateAllMoves(WHITE);
-    calculateAllMoves(BLACK);
-    // Recalculate White moves because initially, black moves were empty
-    calculateAllMoves(WHITE);
+
+    // Reserve room for a long game and search, so that making moves does not allocate
+    stateHistory.reserve(1024);
+    moveHistory.reserve(1024);
+}
+
+// @purpose: Copies the position of another board, so that it can be searched independently
+// @parameters: Board to copy, true to reserve room for a search on the copy - false for a copy that is thrown away
+// @return: None
+Board::Board(const Board& other, bool reserveHistory)
+    : board{ 0 },
+      pieceBB{ { 0 } },
+      colorBB{ 0 },
+      occupiedBB(0),
+      WhiteKing(0),
+      BlackKing(0),
+      charBoard(new char[Chess::NumRanks * Chess::NumFiles]),
+      fen(other.fen),
+      gameStatus(other.gameStatus),
+      hashKey(0),
+      pawnKey(0),
+      materialScore{ { 0 } },
+      phase(0),
+      stateHistory(),
+      moveHistory(),
+      whiteMoves(),
+      blackMoves(),
+      sparePieces(),
+      protectedBB{ 0 },
+      checkersBB{ 0 },
+      checkMaskBB{ 0 },
+      movesValid{ false },
+      conditionsValid{ false },
+      statusValid(false)
+{
+    // Create a new piece for every piece on the other board
+    // The squares come from the pieces themselves, so the copy is right even if the other board's bitboards are not
+    for (int sq = 0; sq < Chess::NumSquares; ++sq)
+    {
+        if (other.board[sq])
+        {
+            placePiece(createPiece(other.board[sq]->getType(), other.board[sq]->getColor(), (Squares)sq), (Squares)sq);
+        }
+    }
+    setCharBoard();
+    WhiteKing = board[Bitboards::lsb(pieceBB[WHITE][KING])];
+    BlackKing = board[Bitboards::lsb(pieceBB[BLACK][KING])];
+    hashKey = other.hashKey;
+
+    // Only the keys of the earlier positions are copied - they are needed to detect repetitions,
+    // but the moves that led to them can not be undone on this board
+    // Reserving room for a search costs more than a short-lived copy does, so such a copy only takes what it copies
+    stateHistory.reserve(reserveHistory ? std::max(other.stateHistory.size(), (size_t)1024) : other.stateHistory.size());
+    for (std::vector<BoardState>::const_iterator it = other.stateHistory.begin(); it != other.stateHistory.end(); ++it)
+    {
+        BoardState state = *it;
+        state.move = PackedMove();
+        state.pieceMoved = 0;
+        state.pieceCaptured = 0;
+        stateHistory.push_back(state);
+    }
+    if (reserveHistory)
+    {
+        moveHistory.reserve(1024);
+    }
 }
 
 // Default Destructor
 Board::~Board()
 {
+    // Delete the pieces that are on the board
+    Bitboard pieces = occupiedBB;
+    while (pieces)
+    {
+        delete board[Bitboards::popLsb(pieces)];
+    }
+
+    // Delete the pieces that were taken off of the board by a move
+    for (std::vector<BoardState>::iterator it = stateHistory.begin(); it != stateHistory.end(); ++it)
+    {
+        delete it->pieceCaptured;
+
+        // A promoted Pawn is replaced by the new piece
+        if (it->move.isPromotion())
+        {
+            delete it->pieceMoved;
+        }
+    }
+
+    // Delete the promoted pieces that are waiting to be reused
+    for (int color = WHITE; color <= BLACK; ++color)
+    {
+        for (int type = PAWN; type < NUM_PIECES; ++type)
+        {
+            for (std::vector<Piece*>::iterator it = sparePieces[color][type].begin(); it != sparePieces[color][type].end(); ++it)
+            {
+                delete *it;
+            }
+        }
+    }
 
+    delete[] charBoard;
 }
 
 // @purpose: Construct and initalize all pieces on the board
@@ -79,53 +189,53 @@ void Board::initializeBoard()
             switch (fen.piecePlacement[index])
             {
             case 'r':
-                board[boardIndex] = new Rook(BLACK, (Squares)boardIndex);
+                placePiece(new Rook(BLACK, (Squares)boardIndex), (Squares)boardIndex);
                 break;
 
             case 'R':
-                board[boardIndex] = new Rook(WHITE, (Squares)boardIndex);
+                placePiece(new Rook(WHITE, (Squares)boardIndex), (Squares)boardIndex);
                 break;
 
             case 'n':
-                board[boardIndex] = new Knight(BLACK, (Squares)boardIndex);
+                placePiece(new Knight(BLACK, (Squares)boardIndex), (Squares)boardIndex);
                 break;
 
             case 'N':
-                board[boardIndex] = new Knight(WHITE, (Squares)boardIndex);
+                placePiece(new Knight(WHITE, (Squares)boardIndex), (Squares)boardIndex);
                 break;
 
             case 'b':
-                board[boardIndex] = new Bishop(BLACK, (Squares)boardIndex);
+                placePiece(new Bishop(BLACK, (Squares)boardIndex), (Squares)boardIndex);
                 break;
 
             case 'B':
-                board[boardIndex] = new Bishop(WHITE, (Squares)boardIndex);
+                placePiece(new Bishop(WHITE, (Squares)boardIndex), (Squares)boardIndex);
                 break;
 
             case 'q':
-                board[boardIndex] = new Queen(BLACK, (Squares)boardIndex);
+                placePiece(new Queen(BLACK, (Squares)boardIndex), (Squares)boardIndex);
                 break;
 
             case 'Q':
-                board[boardIndex] = new Queen(WHITE, (Squares)boardIndex);
+                placePiece(new Queen(WHITE, (Squares)boardIndex), (Squares)boardIndex);
                 break;
 
             case 'k':
-                board[boardIndex] = new King(BLACK, (Squares)boardIndex);
+                placePiece(new King(BLACK, (Squares)boardIndex), (Squares)boardIndex);
                 BlackKing = board[boardIndex];
                 break;
 
             case 'K':
-                board[boardIndex] = new King(WHITE, (Squares)boardIndex);
+                placePiece(new King(WHITE, (Squares)boardIndex), (Squares)boardIndex);
                 WhiteKing = board[boardIndex];
                 break;
 
             case 'p':
-                board[boardIndex] = new Pawn(BLACK, (Squares)boardIndex);
+                placePiece(new Pawn(BLACK, (Squares)boardIndex), (Squares)boardIndex);
                 break;
 
             case 'P':
-                board[boardIndex] = new Pawn(WHITE, (Squares)boardIndex);
+                placePiece(new Pawn(WHITE, (Squares)boardIndex), (Squares)boardIndex);
                 break;
 
             case '/':
@@ -182,12 +292,13 @@ void Board::printBoardToConsole()
 // @return: None
 void Board::printAllMoves(Colors turn)
 {
+    MoveList* moves = getAllMoves(turn);
+
     for (int square = A8; square <= H1; ++square)
     {
-        if (board[square] != 0)
+        if (board[square] != 0 && board[square]->getColor() == turn)
         {
-            board[square]->calculateMoves(this, turn);
-            board[square]->printMoves();
+            board[square]->printMoves(moves);
         }
     }
     Logger::log("\n");
@@ -216,7 +327,9 @@ void Board::printMoveHistory(bool newline)
 // @return: None
 void Board::calculateFen()
 {
-    fen.constructFen(getPiecePlacement());
+    const char* pieces = getPiecePlacement();
+    fen.constructFen(pieces);
+    delete[] pieces;
 }
 
 // @purpose: Returns the FEN object of the game state
@@ -232,6 +345,13 @@ Fen* Board::getFen()
 // @return: GameResults status
 GameResults Board::getGameStatus()
 {
+    // Only check for the endgame once per position
+    if (!statusValid)
+    {
+        gameStatus = checkEndgame();
+        statusValid = true;
+    }
+
     return gameStatus;
 }
 
@@ -249,7 +369,7 @@ const char* Board::getPiecePlacement()
     for (int square = A8; square <= H1; ++square)
     {
         // Place the '/' at the end of each rank
-        if (square >= A8 && square % Chess::NumRanks == 0)
+        if (square > A8 && square % Chess::NumRanks == 0)
         {
             if (emptySquares > 0)
             {
@@ -293,9 +413,9 @@ const char* Board::getPiecePlacement()
     }    
 
     // Fill the rest of the string with Null Characters
-    while (++fenIndex < MaxFenLength)
+    while (fenIndex < MaxFenLength)
     {
-        piecePlacement[fenIndex] = '\0';
+        piecePlacement[fenIndex++] = '\0';
     }
     
     return piecePlacement;
@@ -306,7 +426,7 @@ const char* Board::getPiecePlacement()
 // @return: const char* char representation
 const char* Board::getFenString()
 {
-    fen.constructFen(getPiecePlacement());
+    calculateFen();
     return fen.fen;
 }
 
@@ -318,6 +438,22 @@ const char* Board::getCharBoard()
     return charBoard;
 }
 
+// @purpose: Gets the Zobrist key of the current position
+// @parameters: None
+// @return: ZobristKey of the pieces, castling rights, En Passant file and side to move
+ZobristKey Board::getHash()
+{
+    return hashKey;
+}
+
+// @purpose: Gets the Zobrist key of only the Pawns of the current position
+// @parameters: None
+// @return: ZobristKey of the Pawns of both colors
+ZobristKey Board::getPawnHash()
+{
+    return pawnKey;
+}
+
 // @purpose: Generates a 64-length character array that represents the board state
 // @parameters: None
 // @return: const char* char representation
@@ -336,34 +472,59 @@ void Board::setCharBoard()
     }
 }
 
-// @purpose: Tells the board that a king is in check from a piece
-// @parameters: Path from checker to king, color of king
-// @return: None
-void Board::addCheckPath(sqVector checkPath, Colors king)
+// @purpose: Gets the pieces that are giving check to a king
+// @parameters: Color of king
+// @return: Bitboard of all enemy pieces attacking the king
+Bitboard Board::getCheckers(Colors king)
 {
-    if (king == WHITE)
+    if (!conditionsValid[king])
     {
-        whiteCheckPaths.push_back(checkPath);
-    }
-    else
-    {
-        blackCheckPaths.push_back(checkPath);
+        calculateConditions(king);
     }
+
+    return checkersBB[king];
 }
 
-// @purpose: Gets all of the check paths from an enemy to a king
+// @purpose: Gets the squares that a non-King move must land on to resolve check
 // @parameters: Color of king
-// @return: vector of paths from which the king is in check
-std::vector<sqVector>* Board::getCheckPaths(Colors king)
+// @return: Bitboard of the checker and blocking squares, every square if not in check
+Bitboard Board::getCheckMask(Colors king)
 {
-    if (king == WHITE)
+    if (!conditionsValid[king])
     {
-        return &whiteCheckPaths;
+        calculateConditions(king);
     }
-    else
+
+    return checkMaskBB[king];
+}
+
+// @purpose: Checks if a king is in check
+// @parameters: Color of king
+// @return: true if the king is attacked, false otherwise
+bool Board::isInCheck(Colors king)
+{
+    // Use the calculated conditions if they exist, otherwise only look for attackers
+    if (conditionsValid[king])
     {
-        return &blackCheckPaths;
+        return checkersBB[king] != 0;
     }
+
+    return getAttackers(Bitboards::lsb(pieceBB[king][KING]), Chess::enemy[king], occupiedBB) != 0;
+}
+
+// @purpose: Gets all pieces of one color that attack a square
+// @parameters: Square to attack, Color of the attackers, Bitboard of occupied squares to slide through
+// @return: Bitboard of all attacking pieces
+Bitboard Board::getAttackers(Squares sq, Colors attacker, Bitboard occupied)
+{
+    const Bitboard* pieces = pieceBB[attacker];
+
+    // Look backwards from the square - a Pawn attacks this square if this square would attack it as an enemy Pawn
+    return (Bitboards::pawnAttacks(Chess::enemy[attacker], sq) & pieces[PAWN]) |
+           (Bitboards::knightAttacks(sq) & pieces[KNIGHT]) |
+           (Bitboards::kingAttacks(sq) & pieces[KING]) |
+           (Bitboards::bishopAttacks(sq, occupied) & (pieces[BISHOP] | pieces[QUEEN])) |
+           (Bitboards::rookAttacks(sq, occupied) & (pieces[ROOK] | pieces[QUEEN]));
 }
 
 // @purpose: Get a reference to a piece on the board
@@ -374,6 +535,54 @@ Piece* Board::getPieceAt(Squares pos)
     return board[pos];
 }
 
+// @purpose: Get the Bitboard of one type of piece of one color
+// @parameters: Color of the pieces, Type of the pieces
+// @return: Bitboard of all squares holding that piece
+Bitboard Board::getPieces(Colors color, PieceTypes type)
+{
+    return pieceBB[color][type];
+}
+
+// @purpose: Get the Bitboard of all pieces of one color
+// @parameters: Color of the pieces
+// @return: Bitboard of all squares occupied by that color
+Bitboard Board::getOccupancy(Colors color)
+{
+    return colorBB[color];
+}
+
+// @purpose: Get the Bitboard of all pieces on the board
+// @parameters: None
+// @return: Bitboard of all occupied squares
+Bitboard Board::getOccupancy()
+{
+    return occupiedBB;
+}
+
+// @purpose: Get the material and Piece Square Table score of one color, kept up to date by every move
+// @parameters: Color of the pieces, Phase of the game to score the pieces for
+// @return: Sum of the piece scores and their Piece Square Table modifiers
+int Board::getMaterialScore(Colors color, GamePhases phase)
+{
+    return materialScore[color][phase];
+}
+
+// @purpose: Get how far the game is from the endgame, kept up to date by every move
+// @parameters: None
+// @return: Sum of the PiecePhases of all pieces on the board, TOTAL_PHASE at the start of the game
+int Board::getPhase()
+{
+    return phase;
+}
+
+// @purpose: Counts the pieces of one type and color
+// @parameters: Color of the pieces, Type of the pieces
+// @return: Number of those pieces on the board
+int Board::getPieceCount(Colors color, PieceTypes type)
+{
+    return Bitboards::popCount(pieceBB[color][type]);
+}
+
 // @purpose: Get a reference to the king of a given color
 // @parameters: Color of the King
 // @return: Piece reference
@@ -394,53 +603,49 @@ Piece* Board::getKing(Colors color)
 // @return: None
 void Board::calculateAllMoves(Colors pieceColor)
 {
-    sqVector* tmp;
-    mvVector* tmpMv = 0;
-    mvVector* moves = 0;
-    sqVector* protects = 0;
+    MoveList* moves = 0;
 
     // Only Update the moves array of the current color
     if (pieceColor == WHITE)
     {
         moves = &whiteMoves;
-        protects = &whiteProtecting;
     }
     else
     {
         moves = &blackMoves;
-        protects = &blackProtecting;
     }
 
     moves->clear();
-    protects->clear();
 
-    for (int square = A8; square <= H1; square++)
+    // The pieces need to know about any checks and pins before calculating moves
+    if (!conditionsValid[pieceColor])
     {
-        if (board[square] == 0) continue;
+        calculateConditions(pieceColor);
+    }
 
-        if (board[square]->getColor() == pieceColor)
-        {
-            // Calculate moves for a piece
-            board[square]->calculateMoves(this, pieceColor);
-
-            // Get the Moves
-            tmpMv = board[square]->getMoves();
-            moves->insert(moves->end(), tmpMv->begin(), tmpMv->end());
-            tmpMv = 0;
-
-            // Get the squares that the piece is protecting
-            tmp = board[square]->getProtecting();
-            protects->insert(protects->end(), tmp->begin(), tmp->end());
-            tmp = 0;
-        }
+    // Only visit the squares that hold a piece of this color
+    Bitboard pieces = colorBB[pieceColor];
+    while (pieces)
+    {
+        Squares square = Bitboards::popLsb(pieces);
+
+        // Calculate moves for a piece
+        board[square]->calculateMoves(this, *moves);
     }
+
+    movesValid[pieceColor] = true;
 }
 
-// @purpose: Get all moves of all pieces of one color
+// @purpose: Get all moves of all pieces of one color, calculating them if the board has changed
 // @parameters: Color of the pieces to calculate moves for
-// @return: vector of all moves that the color can move to
-mvVector* Board::getAllMoves(Colors pieceColor)
+// @return: list of all moves that the color can move to
+MoveList* Board::getAllMoves(Colors pieceColor)
 {
+    if (!movesValid[pieceColor])
+    {
+        calculateAllMoves(pieceColor);
+    }
+
     if (pieceColor == WHITE)
     {
         return &whiteMoves;
@@ -451,6 +656,112 @@ mvVector* Board::getAllMoves(Colors pieceColor)
     }
 }
 
+// @purpose: Get all moves of the piece on one square
+// @parameters: Square of the piece, Move list to fill
+// @return: None
+void Board::getPieceMoves(Squares sq, MoveList& moveList)
+{
+    moveList.clear();
+    if (board[sq] == 0)
+    {
+        return;
+    }
+
+    MoveList* moves = getAllMoves(board[sq]->getColor());
+    for (MoveList::iterator it = moves->begin(); it != moves->end(); ++it)
+    {
+        if (it->getStart() == sq)
+        {
+            moveList.add(*it);
+        }
+    }
+}
+
+// @purpose: Builds the full Move with display information for a move in the current position
+// @parameters: PackedMove to build from
+// @return: Move with the pieces involved and any disambiguation
+Move Board::createMove(PackedMove code)
+{
+    // Characters of the pieces that a Pawn can promote to, starting at KNIGHT
+    const char promotionChars[4] = { 'N', 'B', 'R', 'Q' };
+
+    Move move;
+    move.code = code;
+    move.start = code.getStart();
+    move.end = code.getEnd();
+    move.pieceMoved = board[move.start];
+    move.moveNumber = fen.fullmoveNumber;
+
+    Colors color = move.pieceMoved->getColor();
+
+    // The En Passant Pawn is directly behind the end square
+    if (code.isEnPassant())
+    {
+        move.isEnPassant = true;
+        move.pieceCaptured = board[(color == WHITE) ? move.end + Chess::NumFiles : move.end - Chess::NumFiles];
+    }
+    else
+    {
+        move.pieceCaptured = board[move.end];
+    }
+
+    // The Rook castles from the corner on the same side as the King's end square
+    if (code.getFlags() == PackedMove::KING_CASTLE)
+    {
+        move.castledFrom = (Squares)(move.end + 1);
+        move.pieceCastled = board[move.castledFrom];
+    }
+    else if (code.getFlags() == PackedMove::QUEEN_CASTLE)
+    {
+        move.castledFrom = (Squares)(move.end - 2);
+        move.pieceCastled = board[move.castledFrom];
+    }
+
+    if (code.isPromotion())
+    {
+        move.targetPromotion = promotionChars[code.getPromotion() - KNIGHT];
+        if (color == BLACK)
+        {
+            move.targetPromotion = tolower(move.targetPromotion);
+        }
+    }
+
+    // Check if any other of the same piece could move to the same square
+    PieceTypes type = move.pieceMoved->getType();
+    if (type == PAWN || type == KING)
+    {
+        return move;
+    }
+
+    MoveList* moves = getAllMoves(color);
+    for (MoveList::iterator it = moves->begin(); it != moves->end(); ++it)
+    {
+        Squares potentialDiambiguation = it->getStart();
+
+        if (it->getEnd() != move.end ||
+            potentialDiambiguation == move.start ||
+            board[potentialDiambiguation]->getType() != type)
+        {
+            continue;
+        }
+
+        // Check if the other piece is on a different file
+        if (potentialDiambiguation % Chess::NumFiles !=
+            move.start % Chess::NumFiles)
+        {
+            move.fileDisambig = Chess::File[move.start % Chess::NumFiles];
+        }
+        // Check if the other piece is on a different rank
+        else if (potentialDiambiguation / Chess::NumRanks !=
+            move.start / Chess::NumRanks)
+        {
+            move.rankDisambig = Chess::Rank[move.start / Chess::NumRanks];
+        }
+    }
+
+    return move;
+}
+
 // @purpose: Get the move hisotry for the game
 // @parameters: None
 // @return: Vector of moves that have been played
@@ -459,77 +770,116 @@ mvVector* Board::getMoveHistory()
     return &moveHistory;
 }
 
-// @purpose: Get all squares that one piece is protecting
-// @parameters: Color of the pieces to calculate moves for
-// @return: vector of all squares that the color can move to
-sqVector* Board::getAllProtected(Colors pieceColor)
+// @purpose: Get all squares that one color is protecting - looking through the enemy King
+// @parameters: Color of the protecting pieces
+// @return: Bitboard of all squares that the color is protecting
+Bitboard Board::getAllProtected(Colors pieceColor)
 {
-    if (pieceColor == WHITE)
-    {
-        return &whiteProtecting;
-    }
-    else
+    // The protected squares are calculated along with the enemy King's conditions
+    Colors king = Chess::enemy[pieceColor];
+    if (!conditionsValid[king])
     {
-        return &blackProtecting;
+        calculateConditions(king);
     }
+
+    return protectedBB[pieceColor];
 }
 
 //@purpose: Moves a piece from one square to another
-// @parameters: Move object with all move information
+// @parameters: PackedMove to make
 // @return: None
-void Board::makeMove(Move move)
+void Board::makeMove(PackedMove move)
 {
-    // Track the move history
-    move.oldFen = fen;
-
-    // If the end square is not empty, capture that piece
-    if (board[move.end] != 0)
+    Squares start = move.getStart();
+    Squares end = move.getEnd();
+
+    // Save everything that the move itself can not restore
+    BoardState state;
+    state.move = move;
+    state.pieceMoved = board[start];
+    state.pieceCaptured = 0;
+    state.kingCastleWhite = fen.kingCastleWhite;
+    state.queenCastleWhite = fen.queenCastleWhite;
+    state.kingCastleBlack = fen.kingCastleBlack;
+    state.queenCastleBlack = fen.queenCastleBlack;
+    state.enPassantTarget = fen.enPassantTarget;
+    state.halfmoveClock = fen.halfmoveClock;
+    state.fullmoveNumber = fen.fullmoveNumber;
+    state.hashKey = hashKey;
+
+    // Remove the castling rights and En Passant target from the key, they are added back once updated
+    hashKey ^= Zobrist::castling(getCastlingRights()) ^ Zobrist::enPassant(fen.enPassantTarget);
+
+    // Capture the piece on the end square, or the Pawn behind it for En Passant
+    if (move.isEnPassant())
     {
-        move.pieceCaptured = board[move.end];
-        board[move.end] = 0;
-
-        // Reset the Halfmove Clock
-        fen.halfmoveClock = 0;
+        state.pieceCaptured = removePiece((Squares)((fen.activeColor == WHITE) ? end + Chess::NumFiles : end - Chess::NumFiles));
+    }
+    else if (board[end] != 0)
+    {
+        state.pieceCaptured = removePiece(end);
     }
-
-    // Handle En Passant
-    checkEnPassant(&move);
 
     // Handle Castling
-    checkCastling(&move);
+    checkCastling(move);
 
     // Move the piece
-    movePiece(move.start, move.end);
+    movePiece(start, end);
 
     // Handle Pawn Promotion
-    if (move.targetPromotion != '\0')
+    if (move.isPromotion())
     {
-        promotePawn(&move);
+        promotePawn(move);
     }
 
-    // Log the Move in the Move History
-    moveHistory.push_back(move);
+    // Handle En Passant
+    checkEnPassant(move);
 
-    // Update the Character Representation of the Board
-    setCharBoard();
+    // Captures and Pawn moves reset the Halfmove Clock
+    if (state.pieceCaptured != 0 || state.pieceMoved->getType() == PAWN)
+    {
+        fen.halfmoveClock = 0;
+    }
+    else
+    {
+        fen.halfmoveClock += 1;
+    }
 
-    // Clear all Pins and Checks before re-calculating moves
-    clearAllConditions();
+    // Increment the Full move clock after every Black move
+    if (fen.activeColor == BLACK)
+    {
+        fen.fullmoveNumber += 1;
+    }
 
-    // Update the possible moves of the color that just moved
-    calculateAllMoves(fen.activeColor);
+    stateHistory.push_back(state);
 
     // Update which color's turn it is
     fen.activeColor = Chess::enemy[fen.activeColor];
 
-    // Update the possible moves of the color who will now move
-    calculateAllMoves(fen.activeColor);
+    // Add the new castling rights, En Passant target and side to move to the key
+    hashKey ^= Zobrist::castling(getCastlingRights()) ^ Zobrist::enPassant(fen.enPassantTarget) ^ Zobrist::side();
 
-    // Update the Fen
-    calculateFen();
+    // Moves, checks and the game status are only calculated when asked for
+    invalidate();
+}
+
+// @purpose: Makes a move of the game and saves it to the move history
+// @parameters: Move object with all move information
+// @return: None
+void Board::makeMove(Move move)
+{
+    move.moveNumber = fen.fullmoveNumber;
 
-    // Check for the EndGame
-    processEndgame();
+    makeMove(move.code);
+
+    // The promoted piece only exists once the move has been made
+    if (move.code.isPromotion())
+    {
+        move.piecePromoted = board[move.end];
+    }
+
+    // Log the Move in the Move History
+    moveHistory.push_back(move);
 }
 
 // @purpose: Un-makes the last move
@@ -537,66 +887,120 @@ void Board::makeMove(Move move)
 // @return: None
 void Board::undoMove()
 {
-    // Check if there are no moves to undo
-    if (moveHistory.empty())
+    // Check if there are no moves to undo - moves made before the board was copied can not be undone
+    if (stateHistory.empty() || stateHistory.back().pieceMoved == 0)
     {
         return;
     }
+
     // Get the last move
-    Move lastMove = moveHistory.back();
-    moveHistory.pop_back();
+    const BoardState& state = stateHistory.back();
+    PackedMove lastMove = state.move;
+    Squares start = lastMove.getStart();
+    Squares end = lastMove.getEnd();
 
     // Undo a Pawn Promotion
-    if (lastMove.piecePromoted != 0)
+    if (lastMove.isPromotion())
     {
-        // Delete the new piece
-        delete board[lastMove.end];
-        lastMove.piecePromoted = 0;
+        // Save the new piece to be reused by the next promotion
+        Piece* promoted = removePiece(end);
+        sparePieces[promoted->getColor()][promoted->getType()].push_back(promoted);
 
         // Restore the Pawn - in the final rank
-        board[lastMove.end] = lastMove.pieceMoved;
+        placePiece(state.pieceMoved, end);
     }
 
     // Move the piece back to its starting square
-    movePiece(lastMove.end, lastMove.start);
+    movePiece(end, start);
 
     // Restore a captured Piece
-    if (lastMove.pieceCaptured != 0)
+    if (state.pieceCaptured != 0)
     {
-        board[lastMove.pieceCaptured->getPos()] = lastMove.pieceCaptured;
+        placePiece(state.pieceCaptured, state.pieceCaptured->getPos());
     }
 
     // Restore Castling
-    if (lastMove.pieceCastled != 0)
+    if (lastMove.isCastle())
     {
-        // Clear the space where the Rook moved to
-        board[lastMove.pieceCastled->getPos()] = 0;
+        Squares castledFrom = (lastMove.getFlags() == PackedMove::KING_CASTLE) ? (Squares)(end + 1) : (Squares)(end - 2);
+        Squares castledTo = (lastMove.getFlags() == PackedMove::KING_CASTLE) ? (Squares)(end - 1) : (Squares)(end + 1);
+
         // Restore the position of the Rook
-        lastMove.pieceCastled->makeMove(lastMove.castledFrom);
-        board[lastMove.castledFrom] = lastMove.pieceCastled;
+        movePiece(castledTo, castledFrom);
 
         // Restore the 'hasMoved' flags that are used in calculating Castling rights
-        lastMove.pieceMoved->setHasMoved(false);
-        lastMove.pieceCastled->setHasMoved(false);
+        state.pieceMoved->setHasMoved(false);
+        board[castledFrom]->setHasMoved(false);
     }
 
-    // Retore the Fen
-    fen = lastMove.oldFen;
+    // Restore the Fen
+    fen.kingCastleWhite = state.kingCastleWhite;
+    fen.queenCastleWhite = state.queenCastleWhite;
+    fen.kingCastleBlack = state.kingCastleBlack;
+    fen.queenCastleBlack = state.queenCastleBlack;
+    fen.enPassantTarget = state.enPassantTarget;
+    fen.halfmoveClock = state.halfmoveClock;
+    fen.fullmoveNumber = state.fullmoveNumber;
+    fen.activeColor = Chess::enemy[fen.activeColor];
+    hashKey = state.hashKey;
+    stateHistory.pop_back();
 
-    // Update the Character Representation of the Board
-    setCharBoard();
+    // Remove the move from the game history if it was a move of the game
+    if (moveHistory.size() > stateHistory.size())
+    {
+        moveHistory.pop_back();
+    }
 
-    // Clear all Pins and Checks before re-calculating moves
-    clearAllConditions();
+    // Moves, checks and the game status are only calculated when asked for
+    invalidate();
+}
 
-    // Recalculate the Enemies moves
-    calculateAllMoves(Chess::enemy[fen.activeColor]);
+// @purpose: Passes the turn to the other color without moving - used by the search for Null Move Pruning
+// @parameters: None
+// @return: None
+void Board::makeNullMove()
+{
+    // Save the state that passing changes
+    BoardState state;
+    state.pieceMoved = 0;
+    state.pieceCaptured = 0;
+    state.kingCastleWhite = fen.kingCastleWhite;
+    state.queenCastleWhite = fen.queenCastleWhite;
+    state.kingCastleBlack = fen.kingCastleBlack;
+    state.queenCastleBlack = fen.queenCastleBlack;
+    state.enPassantTarget = fen.enPassantTarget;
+    state.halfmoveClock = fen.halfmoveClock;
+    state.fullmoveNumber = fen.fullmoveNumber;
+    state.hashKey = hashKey;
+    stateHistory.push_back(state);
+
+    // Passing gives up any En Passant capture
+    hashKey ^= Zobrist::enPassant(fen.enPassantTarget) ^ Zobrist::side();
+    fen.enPassantTarget = INVALID;
+
+    // A position before the pass can not be repeated by the moves after it
+    fen.halfmoveClock = 0;
 
-    // Recalculate the colors moves who undid their turn
-    calculateAllMoves(fen.activeColor);
+    fen.activeColor = Chess::enemy[fen.activeColor];
 
-    // Check for the EndGame
-    processEndgame();
+    // Moves, checks and the game status are only calculated when asked for
+    invalidate();
+}
+
+// @purpose: Un-makes a null move
+// @parameters: None
+// @return: None
+void Board::undoNullMove()
+{
+    const BoardState& state = stateHistory.back();
+    fen.enPassantTarget = state.enPassantTarget;
+    fen.halfmoveClock = state.halfmoveClock;
+    fen.activeColor = Chess::enemy[fen.activeColor];
+    hashKey = state.hashKey;
+    stateHistory.pop_back();
+
+    // Moves, checks and the game status are only calculated when asked for
+    invalidate();
 }
 
 // @purpose: Checks for an ending condition
@@ -604,14 +1008,13 @@ void Board::undoMove()
 // @return: Enumeration of game ends
 GameResults Board::checkEndgame()
 {
-    mvVector* moves = getAllMoves(fen.activeColor);
-    std::vector<sqVector>* checkPaths = getCheckPaths(fen.activeColor);
+    MoveList* moves = getAllMoves(fen.activeColor);
 
     // Check if there are no legal moves
     if (moves->empty())
     {
         // Check if the current color is in check
-        if (!checkPaths->empty())
+        if (isInCheck(fen.activeColor))
         {
             // CheckMate
             if (fen.activeColor == WHITE)
@@ -635,29 +1038,13 @@ GameResults Board::checkEndgame()
         return DRAW_50MOVES;
     }
 
-    // Check for 3-fold repetition
+    // Check for 3-fold repetition - positions with the same key have the same pieces, rights and side to move
+    // Only the positions since the last capture or Pawn move can repeat, and only every other one has the same side to move
     int threeFold = 0;
-    mvVector::iterator it = moveHistory.end();
-    while (it != moveHistory.begin())
+    int oldest = std::max((int)stateHistory.size() - fen.halfmoveClock, 0);
+    for (int i = (int)stateHistory.size() - 2; i >= oldest; i -= 2)
     {
-        --it;
-
-        // Captures, Pawn Moves, and Castles reset the repetition rule
-        if (it->pieceMoved->getType() == PAWN ||
-            it->pieceCastled != 0 ||
-            it->pieceCaptured != 0)
-        {
-            break;
-        }
-
-        // If the piece placement and castling rights are the same, count a repetition
-        if (strcmp(fen.piecePlacement,it->oldFen.piecePlacement) == 0 &&
-            fen.activeColor == it->oldFen.activeColor &&
-            fen.enPassantTarget == it->oldFen.enPassantTarget &&
-            fen.kingCastleWhite == it->oldFen.kingCastleWhite &&
-            fen.queenCastleWhite == it->oldFen.queenCastleWhite &&
-            fen.kingCastleBlack == it->oldFen.kingCastleBlack &&
-            fen.queenCastleBlack == it->oldFen.queenCastleBlack)
+        if (stateHistory[i].hashKey == hashKey)
         {
             if (++threeFold >= 3)
             {
@@ -674,58 +1061,76 @@ GameResults Board::checkEndgame()
 // @return: None
 void Board::movePiece(Squares start, Squares end)
 {
-    // Check if the moving piece is a pawn
-    if (tolower(board[start]->getCharId()) == 'p')
-    {
-        // Reset the Halfmove Clock
-        fen.halfmoveClock = 0;
-    }
     // Move the piece from the starting positon to the ending position
-    board[start]->makeMove(end);
-    board[end] = board[start];
-    board[start] = 0;
-
-    // Increment the halfmove clock after every move
-    fen.halfmoveClock += 1;
-
-    // Increment the Full move clock after every Block moves
-    if (fen.activeColor == BLACK)
-    {
-        fen.fullmoveNumber += 1;
-    }   
+    Piece* piece = removePiece(start);
+    piece->makeMove(end);
+    placePiece(piece, end);
 }
 
-// @purpose: Handle all En Passant Actions
-// @parameters: Move object to update
+// @purpose: Puts a piece on an empty square and updates the Bitboards
+// @parameters: Piece to place, Square to place it on
 // @return: None
-void Board::checkEnPassant(Move* move)
+void Board::placePiece(Piece* piece, Squares sq)
 {
-    // Handle En Passant Captures
-    if (move->end == fen.enPassantTarget)
+    Bitboard sqBB = Bitboards::squareBB(sq);
+    Colors color = piece->getColor();
+    PieceTypes type = piece->getType();
+
+    board[sq] = piece;
+    pieceBB[color][type] |= sqBB;
+    colorBB[color] |= sqBB;
+    occupiedBB |= sqBB;
+
+    charBoard[sq] = piece->getCharId();
+    hashKey ^= Zobrist::piece(color, type, sq);
+    if (type == PAWN)
     {
-        if (fen.activeColor == WHITE &&
-            move->pieceMoved->getCharId() == 'P')
-        {
-            move->pieceCaptured = board[(move->end + 8)];
-            board[(move->end + 8)] = 0;
-        }
-        else if (move->pieceMoved->getCharId() == 'p')
-        {
-            move->pieceCaptured = board[(move->end - 8)];
-            board[(move->end - 8)] = 0;
-        }
+        pawnKey ^= Zobrist::piece(color, type, sq);
     }
 
-    // Track En Passant Squares
-    if (move->pieceMoved->getCharId() == 'p' &&
-        abs(move->start - move->end) == 16)
+    materialScore[color][MIDDLEGAME] += PhasePieceScores[MIDDLEGAME][type] + PIECE_PSQT[MIDDLEGAME][type][color][sq];
+    materialScore[color][ENDGAME] += PhasePieceScores[ENDGAME][type] + PIECE_PSQT[ENDGAME][type][color][sq];
+    phase += PiecePhases[type];
+}
+
+// @purpose: Takes a piece off of a square and updates the Bitboards
+// @parameters: Square to clear
+// @return: Piece that was removed
+Piece* Board::removePiece(Squares sq)
+{
+    Piece* piece = board[sq];
+    Bitboard sqBB = Bitboards::squareBB(sq);
+    Colors color = piece->getColor();
+    PieceTypes type = piece->getType();
+
+    board[sq] = 0;
+    pieceBB[color][type] &= ~sqBB;
+    colorBB[color] &= ~sqBB;
+    occupiedBB &= ~sqBB;
+
+    charBoard[sq] = '-';
+    hashKey ^= Zobrist::piece(color, type, sq);
+    if (type == PAWN)
     {
-        fen.enPassantTarget = (Squares)(move->end - 8);
+        pawnKey ^= Zobrist::piece(color, type, sq);
     }
-    else if (move->pieceMoved->getCharId() == 'P' &&
-        abs(move->start - move->end) == 16)
+
+    materialScore[color][MIDDLEGAME] -= PhasePieceScores[MIDDLEGAME][type] + PIECE_PSQT[MIDDLEGAME][type][color][sq];
+    materialScore[color][ENDGAME] -= PhasePieceScores[ENDGAME][type] + PIECE_PSQT[ENDGAME][type][color][sq];
+    phase -= PiecePhases[type];
+
+    return piece;
+}
+
+// @purpose: Handle all En Passant Actions
+// @parameters: Move being made
+// @return: None
+void Board::checkEnPassant(PackedMove move)
+{
+    // Track En Passant Squares - the square that was skipped over
+    if (move.isDoublePush())
     {
-        fen.enPassantTarget = (Squares)(move->end + 8);
+        fen.enPassantTarget = (Squares)((move.getStart() + move.getEnd()) / 2);
     }
     else
     {
@@ -734,157 +1139,249 @@ void Board::checkEnPassant(Move* move)
 }
 
 // @purpose: Handle all Castling Actions
-// @parameters: Move object to update
+// @parameters: Move being made
 // @return: None
-void Board::checkCastling(Move* move)
+void Board::checkCastling(PackedMove move)
 {
-    // Handle White Castling
-    if (move->pieceMoved->getCharId() == 'K')
+    Squares start = move.getStart();
+    Squares end = move.getEnd();
+
+    // Moving a King or Rook off of its starting square, or capturing a Rook there, revokes castling rights
+    if (start == E1 || start == H1 || end == H1)
     {
-        // If a King is Moving, revoke castling rights
         fen.kingCastleWhite = false;
+    }
+    if (start == E1 || start == A1 || end == A1)
+    {
         fen.queenCastleWhite = false;
-
-        // Kingside Castling
-        if (move->start == E1 && move->end == G1)
-        {
-            move->pieceCastled = board[H1];
-            move->castledFrom = H1;
-            movePiece(H1, F1);
-        }
-        // Queenside Castling
-        else if (move->start == E1 && move->end == C1)
-        {
-            move->pieceCastled = board[A1];
-            move->castledFrom = A1;
-            movePiece(A1, D1);
-        }
     }
-
-    // Handle Black Castling
-    if (move->pieceMoved->getCharId() == 'k')
+    if (start == E8 || start == H8 || end == H8)
     {
-        // If a King is Moving, revoke castling rights
         fen.kingCastleBlack = false;
+    }
+    if (start == E8 || start == A8 || end == A8)
+    {
         fen.queenCastleBlack = false;
-
-        // Kingside Castling
-        if (move->start == E8 && move->end == G8)
-        {
-            move->pieceCastled = board[H8];
-            move->castledFrom = H8;
-            movePiece(H8, F8);
-        }
-        // Queenside Castling
-        else if (move->start == E8 && move->end == C8)
-        {
-            move->pieceCastled = board[A8];
-            move->castledFrom = A8;
-            movePiece(A8, D8);
-        }
     }
 
-    // Revoke Castling Rights on Rook Move
-    if (move->pieceMoved->getCharId() == 'R')
+    // Kingside Castling
+    if (move.getFlags() == PackedMove::KING_CASTLE)
     {
-        if (move->start == A1)
-        {
-            fen.queenCastleWhite = false;
-        }
-        else if (move->start == H1)
-        {
-            fen.kingCastleWhite = false;
-        }
+        movePiece((Squares)(end + 1), (Squares)(end - 1));
     }
-    else if (move->pieceMoved->getCharId() == 'r')
+    // Queenside Castling
+    else if (move.getFlags() == PackedMove::QUEEN_CASTLE)
     {
-        if (move->start == A8)
-        {
-            fen.queenCastleBlack = false;
-        }
-        else if (move->start == H8)
-        {
-            fen.kingCastleBlack = false;
-        }
+        movePiece((Squares)(end - 2), (Squares)(end + 1));
     }
 }
 
 // @purpose: Promotes a Pawn that reaches the end of the board
-// @parameters: Move object to update
+// @parameters: Move being made
 // @return: None
-void Board::promotePawn(Move* move)
+void Board::promotePawn(PackedMove move)
 {
+    Squares end = move.getEnd();
+
     // Remove the pawn from the board
-    board[move->end] = 0;
+    Colors color = removePiece(end)->getColor();
+
+    // Replace the Pawn with the Desired piece - reusing a piece from an undone promotion if there is one
+    Piece* promoted = 0;
+    std::vector<Piece*>& spares = sparePieces[color][move.getPromotion()];
+    if (!spares.empty())
+    {
+        promoted = spares.back();
+        spares.pop_back();
+        promoted->makeMove(end);
+        placePiece(promoted, end);
+        return;
+    }
+
+    promoted = createPiece(move.getPromotion(), color, end);
+    placePiece(promoted, end);
+}
 
-    // Replace the Pawn with the Desired piece
-    switch (move->targetPromotion)
+// @purpose: Creates a new piece
+// @parameters: Type of the piece, Color of the piece, Square of the piece
+// @return: The new piece
+Piece* Board::createPiece(PieceTypes type, Colors color, Squares sq)
+{
+    switch (type)
     {
-    case 'r':
-        board[move->end] = new Rook(BLACK, move->end);
-        break;
+    case PAWN:
+        return new Pawn(color, sq);
 
-    case 'R':
-        board[move->end] = new Rook(WHITE, move->end);
-        break;
+    case KNIGHT:
+        return new Knight(color, sq);
 
-    case 'n':
-        board[move->end] = new Knight(BLACK, move->end);
-        break;
+    case BISHOP:
+        return new Bishop(color, sq);
 
-    case 'N':
-        board[move->end] = new Knight(WHITE, move->end);
-        break;
+    case ROOK:
+        return new Rook(color, sq);
 
-    case 'b':
-        board[move->end] = new Bishop(BLACK, move->end);
-        break;
+    case QUEEN:
+        return new Queen(color, sq);
 
-    case 'B':
-        board[move->end] = new Bishop(WHITE, move->end);
-        break;
+    case KING:
+        return new King(color, sq);
 
-    case 'q':
-        board[move->end] = new Queen(BLACK, move->end);
-        break;
+    default:
+        return 0;
+    }
+}
+
+// @purpose: Calculates the checks, pins, and enemy protected squares for one color's King
+// @parameters: Color of the King
+// @return: None
+void Board::calculateConditions(Colors king)
+{
+    Colors enemy = Chess::enemy[king];
+    Squares kingSquare = Bitboards::lsb(pieceBB[king][KING]);
 
-    case 'Q':
-        board[move->end] = new Queen(WHITE, move->end);
-        break;
+    // Clear the pins from the last position
+    Bitboard pieces = colorBB[king];
+    while (pieces)
+    {
+        board[Bitboards::popLsb(pieces)]->clearPin();
     }
 
-    move->piecePromoted = board[move->end];
+    // Look through the King, so that it can not step back along the line of an attack
+    protectedBB[enemy] = calculateAttacks(enemy, occupiedBB & ~pieceBB[king][KING]);
 
-    // Update the Character Representation of the Board
-    setCharBoard();
+    // Any piece attacking the King is giving check
+    Bitboard checkers = getAttackers(kingSquare, enemy, occupiedBB);
+    checkersBB[king] = checkers;
+
+    // A single check can be captured or blocked, a double check can only be escaped by the King
+    if (checkers == 0)
+    {
+        checkMaskBB[king] = ~Bitboards::Empty;
+    }
+    else if (Bitboards::popCount(checkers) == 1)
+    {
+        checkMaskBB[king] = checkers | Bitboards::between(kingSquare, Bitboards::lsb(checkers));
+    }
+    else
+    {
+        checkMaskBB[king] = Bitboards::Empty;
+    }
+
+    // Enemy sliders on a line with the King pin a single friendly piece between them
+    Bitboard snipers = (Bitboards::rookAttacks(kingSquare, Bitboards::Empty) &
+                        (pieceBB[enemy][ROOK] | pieceBB[enemy][QUEEN])) |
+                       (Bitboards::bishopAttacks(kingSquare, Bitboards::Empty) &
+                        (pieceBB[enemy][BISHOP] | pieceBB[enemy][QUEEN]));
+    while (snipers)
+    {
+        Squares sniper = Bitboards::popLsb(snipers);
+        Bitboard path = Bitboards::between(kingSquare, sniper);
+        Bitboard blockers = path & occupiedBB;
+
+        if (Bitboards::popCount(blockers) == 1 && (blockers & colorBB[king]))
+        {
+            // The pinned piece may move anywhere on the path, including capturing the pinning piece
+            board[Bitboards::lsb(blockers)]->setPin(path | Bitboards::squareBB(sniper));
+        }
+    }
+
+    conditionsValid[king] = true;
+}
+
+// @purpose: Calculates every square that one color attacks
+// @parameters: Color of the attacking pieces, Bitboard of occupied squares to slide through
+// @return: Bitboard of all attacked squares
+Bitboard Board::calculateAttacks(Colors attacker, Bitboard occupied)
+{
+    const Bitboard* pieces = pieceBB[attacker];
+    Bitboard attacks = Bitboards::Empty;
+
+    // All Pawns attack at once, shifting diagonally forward without wrapping around the edge files
+    Bitboard pawns = pieces[PAWN];
+    if (attacker == WHITE)
+    {
+        attacks |= ((pawns & ~Bitboards::FileA) >> 9) | ((pawns & ~Bitboards::FileH) >> 7);
+    }
+    else
+    {
+        attacks |= ((pawns & ~Bitboards::FileA) << 7) | ((pawns & ~Bitboards::FileH) << 9);
+    }
+
+    Bitboard knights = pieces[KNIGHT];
+    while (knights)
+    {
+        attacks |= Bitboards::knightAttacks(Bitboards::popLsb(knights));
+    }
+
+    Bitboard diagonals = pieces[BISHOP] | pieces[QUEEN];
+    while (diagonals)
+    {
+        attacks |= Bitboards::bishopAttacks(Bitboards::popLsb(diagonals), occupied);
+    }
+
+    Bitboard lines = pieces[ROOK] | pieces[QUEEN];
+    while (lines)
+    {
+        attacks |= Bitboards::rookAttacks(Bitboards::popLsb(lines), occupied);
+    }
+
+    if (pieces[KING])
+    {
+        attacks |= Bitboards::kingAttacks(Bitboards::lsb(pieces[KING]));
+    }
+
+    return attacks;
 }
 
-// @purpose: Clears the pinnedPath from all pieces
+// @purpose: Packs the current castling rights into Zobrist::CastlingRights bits
 // @parameters: None
-// @return: None
-void Board::clearAllConditions()
+// @return: Castling rights bits
+int Board::getCastlingRights()
+{
+    int rights = 0;
+
+    if (fen.kingCastleWhite) rights |= Zobrist::WHITE_KING_SIDE;
+    if (fen.queenCastleWhite) rights |= Zobrist::WHITE_QUEEN_SIDE;
+    if (fen.kingCastleBlack) rights |= Zobrist::BLACK_KING_SIDE;
+    if (fen.queenCastleBlack) rights |= Zobrist::BLACK_QUEEN_SIDE;
+
+    return rights;
+}
+
+// @purpose: Calculates the Zobrist key of the current position from scratch
+// @parameters: None
+// @return: ZobristKey of the position
+ZobristKey Board::calculateHash()
 {
-    // Clear the check paths
-    whiteCheckPaths.clear();
-    blackCheckPaths.clear();
+    ZobristKey key = 0;
 
-    // Clear all pin paths
-    for (int square = A8; square <= H1; square++)
+    Bitboard pieces = occupiedBB;
+    while (pieces)
     {
-        if (board[square] == 0) continue;
+        Squares sq = Bitboards::popLsb(pieces);
+        key ^= Zobrist::piece(board[sq]->getColor(), board[sq]->getType(), sq);
+    }
+
+    key ^= Zobrist::castling(getCastlingRights());
+    key ^= Zobrist::enPassant(fen.enPassantTarget);
 
-        board[square]->clearPin();
+    if (fen.activeColor == BLACK)
+    {
+        key ^= Zobrist::side();
     }
+
+    return key;
 }
 
-// @purpose: Processes all Endgame functionality
+// @purpose: Marks all calculations as out of date after the board changes
 // @parameters: None
 // @return: None
-void Board::processEndgame()
+void Board::invalidate()
 {
-    // Check if there is an endgame condition
-    gameStatus = checkEndgame();
-    if (gameStatus == IN_PROGRESS) return;
-
-    //Logger::log("%s!\n", Chess::EndgameChars[gameStatus]);
-}
\ No newline at end of file
+    movesValid[WHITE] = false;
+    movesValid[BLACK] = false;
+    conditionsValid[WHITE] = false;
+    conditionsValid[BLACK] = false;
+    statusValid = false;
+}
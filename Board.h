@@ -14,9 +14,13 @@
 
 #include <vector>
 
+#include "Bitboard.h"
 #include "ChessTypes.h"
+#include "EvaluationTypes.h"
 #include "Fen.h"
 #include "Move.h"
+#include "MoveList.h"
+#include "Zobrist.h"
 
 // Forward Declarations
 class Piece;
@@ -28,6 +32,11 @@ public:
     // @parameters: string fen that holds a fen position of a board
     // @return: None
     Board(const char* fen = Chess::startingFen);
+
+    // @purpose: Copies the position of another board, so that it can be searched independently
+    // @parameters: Board to copy, true to reserve room for a search on the copy - false for a copy that is thrown away
+    // @return: None
+    Board(const Board& other, bool reserveHistory = true);
    
     // Default Destructor
     ~Board();
@@ -82,26 +91,76 @@ public:
     // @return: const char* char representation
     const char* getCharBoard();
 
+    // @purpose: Gets the Zobrist key of the current position
+    // @parameters: None
+    // @return: ZobristKey of the pieces, castling rights, En Passant file and side to move
+    ZobristKey getHash();
+
+    // @purpose: Gets the Zobrist key of only the Pawns of the current position
+    // @parameters: None
+    // @return: ZobristKey of the Pawns of both colors
+    ZobristKey getPawnHash();
+
     // @purpose: Generates a 64-length character array that represents the board state
     // @parameters: None
     // @return: const char* char representation
     void setCharBoard();
 
-    // @purpose: Tells the board that a king is in check from a piece
-    // @parameters: Path from checker to king, color of king
-    // @return: None
-    void addCheckPath(sqVector checkPath, Colors king);
+    // @purpose: Gets the pieces that are giving check to a king
+    // @parameters: Color of king
+    // @return: Bitboard of all enemy pieces attacking the king
+    Bitboard getCheckers(Colors king);
+
+    // @purpose: Gets the squares that a non-King move must land on to resolve check
+    // @parameters: Color of king
+    // @return: Bitboard of the checker and blocking squares, every square if not in check
+    Bitboard getCheckMask(Colors king);
 
-    // @purpose: Gets all of the check paths from an enemy to a king
+    // @purpose: Checks if a king is in check
     // @parameters: Color of king
-    // @return: vector of paths from which the king is in check
-    std::vector<sqVector>* getCheckPaths(Colors king);
+    // @return: true if the king is attacked, false otherwise
+    bool isInCheck(Colors king);
+
+    // @purpose: Gets all pieces of one color that attack a square
+    // @parameters: Square to attack, Color of the attackers, Bitboard of occupied squares to slide through
+    // @return: Bitboard of all attacking pieces
+    Bitboard getAttackers(Squares sq, Colors attacker, Bitboard occupied);
 
     // @purpose: Get a reference to a piece on the board
     // @parameters: Square where the piece is
     // @return: Piece reference
     Piece* getPieceAt(Squares pos);
 
+    // @purpose: Get the Bitboard of one type of piece of one color
+    // @parameters: Color of the pieces, Type of the pieces
+    // @return: Bitboard of all squares holding that piece
+    Bitboard getPieces(Colors color, PieceTypes type);
+
+    // @purpose: Get the Bitboard of all pieces of one color
+    // @parameters: Color of the pieces
+    // @return: Bitboard of all squares occupied by that color
+    Bitboard getOccupancy(Colors color);
+
+    // @purpose: Get the Bitboard of all pieces on the board
+    // @parameters: None
+    // @return: Bitboard of all occupied squares
+    Bitboard getOccupancy();
+
+    // @purpose: Get the material and Piece Square Table score of one color, kept up to date by every move
+    // @parameters: Color of the pieces, Phase of the game to score the pieces for
+    // @return: Sum of the piece scores and their Piece Square Table modifiers
+    int getMaterialScore(Colors color, GamePhases phase);
+
+    // @purpose: Get how far the game is from the endgame, kept up to date by every move
+    // @parameters: None
+    // @return: Sum of the PiecePhases of all pieces on the board, TOTAL_PHASE at the start of the game
+    int getPhase();
+
+    // @purpose: Counts the pieces of one type and color
+    // @parameters: Color of the pieces, Type of the pieces
+    // @return: Number of those pieces on the board
+    int getPieceCount(Colors color, PieceTypes type);
+
     // @purpose: Get a reference to the king of a given color
     // @parameters: Color of the King
     // @return: Piece reference
@@ -112,22 +171,37 @@ public:
     // @return: None
     void calculateAllMoves(Colors pieceColor);
 
-    // @purpose: Get all moves of all pieces of one color
+    // @purpose: Get all moves of all pieces of one color, calculating them if the board has changed
     // @parameters: Color of the pieces to calculate moves for
-    // @return: vector of all moves that the color can move to
-    mvVector* getAllMoves(Colors pieceColor);
+    // @return: list of all moves that the color can move to
+    MoveList* getAllMoves(Colors pieceColor);
+
+    // @purpose: Get all moves of the piece on one square
+    // @parameters: Square of the piece, Move list to fill
+    // @return: None
+    void getPieceMoves(Squares sq, MoveList& moveList);
+
+    // @purpose: Builds the full Move with display information for a move in the current position
+    // @parameters: PackedMove to build from
+    // @return: Move with the pieces involved and any disambiguation
+    Move createMove(PackedMove code);
 
     // @purpose: Get the move hisotry for the game
     // @parameters: None
     // @return: Vector of moves that have been played
     mvVector* getMoveHistory();
 
-    // @purpose: Get all squares that one piece is protecting
-    // @parameters: Color of the pieces to calculate moves for
-    // @return: vector of all squares that the color can move to
-    sqVector* getAllProtected(Colors pieceColor);
+    // @purpose: Get all squares that one color is protecting - looking through the enemy King
+    // @parameters: Color of the protecting pieces
+    // @return: Bitboard of all squares that the color is protecting
+    Bitboard getAllProtected(Colors pieceColor);
 
     // @purpose: Moves a piece from one square to another
+    // @parameters: PackedMove to make
+    // @return: None
+    void makeMove(PackedMove move);
+
+    // @purpose: Makes a move of the game and saves it to the move history
     // @parameters: Move object with all move information
     // @return: None
     void makeMove(Move move);
@@ -137,6 +211,16 @@ public:
     // @return: None
     void undoMove();
 
+    // @purpose: Passes the turn to the other color without moving - used by the search for Null Move Pruning
+    // @parameters: None
+    // @return: None
+    void makeNullMove();
+
+    // @purpose: Un-makes a null move
+    // @parameters: None
+    // @return: None
+    void undoNullMove();
+
     // @purpose: Checks if the game is over
     // @parameters: None
     // @return: Enumeration of game ends
@@ -163,6 +247,11 @@ private:
     *   A B C D E F G H
     */
 
+    // Bitboard representation of the board, kept in sync with the board array
+    Bitboard pieceBB[BLACK + 1][NUM_PIECES];
+    Bitboard colorBB[BLACK + 1];
+    Bitboard occupiedBB;
+
     // pointer to the Kings
     Piece* WhiteKing;
     Piece* BlackKing;
@@ -174,52 +263,123 @@ private:
     Fen fen;
     GameResults gameStatus;
 
-    // Holds the move history for this board
+    // Zobrist key of the current position, updated by every move
+    ZobristKey hashKey;
+
+    // Zobrist key of only the Pawns, updated as every Pawn is placed and removed
+    ZobristKey pawnKey;
+
+    // Material and Piece Square Table score of each color in each phase, and the phase of the game
+    // Updated as every piece is placed and removed, so that the evaluation does not need to visit the pieces
+    int materialScore[BLACK + 1][NUM_PHASES];
+    int phase;
+
+    // Holds the state that can not be recovered from a move when it is undone
+    struct BoardState
+    {
+        PackedMove move;
+        Piece* pieceMoved;
+        Piece* pieceCaptured;
+
+        bool kingCastleWhite;
+        bool queenCastleWhite;
+        bool kingCastleBlack;
+        bool queenCastleBlack;
+        Squares enPassantTarget;
+        int halfmoveClock;
+        int fullmoveNumber;
+
+        // Zobrist key of the position before the move, used to detect repetitions
+        ZobristKey hashKey;
+    };
+
+    // Holds the state before every move made on this board, and the moves of the game for display
+    // Moves made while searching are only in the stateHistory
+    std::vector<BoardState> stateHistory;
     mvVector moveHistory;
 
     // Holds all the possible moves for a given color
-    mvVector whiteMoves;
-    mvVector blackMoves;
+    MoveList whiteMoves;
+    MoveList blackMoves;
+
+    // Holds promoted pieces that have been undone, so that they can be reused instead of allocated
+    std::vector<Piece*> sparePieces[BLACK + 1][NUM_PIECES];
 
     // Holds all the squares that a given color is protecting
-    sqVector whiteProtecting;
-    sqVector blackProtecting;
+    Bitboard protectedBB[BLACK + 1];
+
+    // Holds the pieces checking a given color's king, and the squares that resolve the check
+    Bitboard checkersBB[BLACK + 1];
+    Bitboard checkMaskBB[BLACK + 1];
 
-    // Holds The paths from a checker to a king
-    std::vector<sqVector> whiteCheckPaths;
-    std::vector<sqVector> blackCheckPaths;
+    // Determines which calculations are up to date with the current position
+    // These are only calculated when asked for, and are invalidated by every move
+    bool movesValid[BLACK + 1];
+    bool conditionsValid[BLACK + 1];
+    bool statusValid;
 
     // @purpose: Moves a piece from one square to another
     // @parameters: Square start position, Square end position
     // @return: None
     void movePiece(Squares start, Squares end);
 
+    // @purpose: Puts a piece on an empty square and updates the Bitboards
+    // @parameters: Piece to place, Square to place it on
+    // @return: None
+    void placePiece(Piece* piece, Squares sq);
+
+    // @purpose: Takes a piece off of a square and updates the Bitboards
+    // @parameters: Square to clear
+    // @return: Piece that was removed
+    Piece* removePiece(Squares sq);
+
     // @purpose: Handle all En Passant Actions
-    // @parameters: Move object to update
+    // @parameters: Move being made
     // @return: None
-    void checkEnPassant(Move* move);
+    void checkEnPassant(PackedMove move);
 
     // @purpose: Handle all Castling Actions
-    // @parameters: Move object to update
+    // @parameters: Move being made
     // @return: None
-    void checkCastling(Move* move);
+    void checkCastling(PackedMove move);
 
     // @purpose: Promotes a Pawn that reaches the end of the board
-    // @parameters: Move object to update
+    // @parameters: Move being made
     // @return: None
-    void promotePawn(Move* move);
+    void promotePawn(PackedMove move);
 
-    // @purpose: Clears the check conditions and pinnedPath from all pieces
-    // @parameters: None
+    // @purpose: Creates a new piece
+    // @parameters: Type of the piece, Color of the piece, Square of the piece
+    // @return: The new piece
+    Piece* createPiece(PieceTypes type, Colors color, Squares sq);
+
+    // @purpose: Calculates the checks, pins, and enemy protected squares for one color's King
+    // @parameters: Color of the King
     // @return: None
-    void clearAllConditions();
+    void calculateConditions(Colors king);
+
+    // @purpose: Calculates every square that one color attacks
+    // @parameters: Color of the attacking pieces, Bitboard of occupied squares to slide through
+    // @return: Bitboard of all attacked squares
+    Bitboard calculateAttacks(Colors attacker, Bitboard occupied);
 
-    // @purpose: Processes all Endgame functionality
+    // @purpose: Packs the current castling rights into Zobrist::CastlingRights bits
     // @parameters: None
-    // @return: None
-    void processEndgame();
+    // @return: Castling rights bits
+    int getCastlingRights();
+
+    // @purpose: Calculates the Zobrist key of the current position from scratch
+    // @parameters: None
+    // @return: ZobristKey of the position
+    ZobristKey calculateHash();
 
+    // @purpose: Marks all calculations as out of date after the board changes
+    // @parameters: None
+    // @return: None
+    void invalidate();
 
+    // Boards are only copied to be searched, never assigned
+    Board& operator = (const Board&);
 };
 
 #endif //BOARD_H
\ No newline at end of file
@@ -10,7 +10,9 @@
 // E. Koch    04/10/23    Initial Creation of ChessAI class
 //-------------------------------------------------------
 #include <algorithm>
+#include <chrono>
 #include <stdlib.h>
+#include <thread>
 #include <time.h>
 
 #include "Board.h"
@@ -24,16 +26,75 @@
 ChessAI::ChessAI(Colors colorIn, int depthIn)
     : DEPTH(depthIn),
       nodesSearched(0),
+      quiescenceNodesSearched(0),
       aiPlayer(colorIn),
-      board(0)
+      board(0),
+      lastPV(),
+      killers(),
+      history{ { { 0 } } },
+      searchFeatures(ALL_SEARCH_FEATURES),
+      lazyMargin(LAZY_MARGIN),
+      rootDepth(0),
+      stats(),
+      transpositionTable(new TranspositionTable(TranspositionTable::DefaultSizeMB)),
+      pawnTable(),
+      evalCache(EvaluationCache::DefaultSizeMB),
+      helpers(),
+      threadId(0),
+      moveTime(0),
+      clockTime(0),
+      clockIncrement(0),
+      softLimit(0),
+      hardLimit(0),
+      searchStart(),
+      completedDepth(0),
+      stopSearch(false)
 {
     srand(time(NULL));
 }
 
+// @purpose: Construct a helper of a multi-threaded search, sharing the Transposition Table of the main AI
+// @parameters: Main AI of the search, Number of the helper thread
+// @return: None
+ChessAI::ChessAI(ChessAI* mainIn, int threadIdIn)
+    : DEPTH(mainIn->DEPTH),
+      nodesSearched(0),
+      quiescenceNodesSearched(0),
+      aiPlayer(mainIn->aiPlayer),
+      board(0),
+      lastPV(),
+      killers(),
+      history{ { { 0 } } },
+      searchFeatures(mainIn->searchFeatures),
+      lazyMargin(mainIn->lazyMargin),
+      rootDepth(0),
+      stats(),
+      transpositionTable(mainIn->transpositionTable),
+      pawnTable(),
+      evalCache(mainIn->evalCache.getSizeMB()),
+      helpers(),
+      threadId(threadIdIn),
+      moveTime(0),
+      clockTime(0),
+      clockIncrement(0),
+      softLimit(0),
+      hardLimit(0),
+      searchStart(),
+      completedDepth(0),
+      stopSearch(false)
+{
+}
+
     // Default Destructor
 ChessAI::~ChessAI()
 {
+    setThreads(1);
 
+    // Only the main AI owns the Transposition Table
+    if (threadId == 0)
+    {
+        delete transpositionTable;
+    }
 }
 
 // @purpose: Sets the depth of the AI
@@ -42,6 +103,100 @@ ChessAI::~ChessAI()
 void ChessAI::setDepth(int strength)
 {
     DEPTH = strength;
+    moveTime = 0;
+    clockTime = 0;
+    clockIncrement = 0;
+}
+
+// @purpose: Sets the size of the Transposition Table, clearing it
+// @parameters: Size of the table in megabytes
+// @return: None
+void ChessAI::setHashSize(int megabytes)
+{
+    transpositionTable->resize(megabytes);
+}
+
+// @purpose: Sets the size of the Evaluation Cache of every thread, clearing them
+// @parameters: Size of each cache in megabytes
+// @return: None
+void ChessAI::setEvalCacheSize(int megabytes)
+{
+    evalCache.resize(megabytes);
+    for (std::vector<ChessAI*>::iterator it = helpers.begin(); it != helpers.end(); ++it)
+    {
+        (*it)->evalCache.resize(megabytes);
+    }
+}
+
+// @purpose: Sets the number of threads that search together
+// @parameters: Number of threads, including the main thread
+// @return: None
+void ChessAI::setThreads(int threads)
+{
+    int numHelpers = std::max(threads, 1) - 1;
+
+    while ((int)helpers.size() > numHelpers)
+    {
+        delete helpers.back();
+        helpers.pop_back();
+    }
+    while ((int)helpers.size() < numHelpers)
+    {
+        helpers.push_back(new ChessAI(this, (int)helpers.size() + 1));
+    }
+}
+
+// @purpose: Search for a fixed time per move instead of to a fixed depth
+// @parameters: Time to search in milliseconds
+// @return: None
+void ChessAI::setMoveTime(int milliseconds)
+{
+    moveTime = milliseconds;
+    clockTime = 0;
+    clockIncrement = 0;
+}
+
+// @purpose: Search for a share of the remaining clock instead of a fixed depth
+// @parameters: Time left on the clock in milliseconds, Increment per move in milliseconds
+// @return: None
+void ChessAI::setClock(int remaining, int increment)
+{
+    moveTime = 0;
+    clockTime = remaining;
+    clockIncrement = increment;
+}
+
+// @purpose: Turns the selective search techniques on or off, to measure the effect of each
+// @parameters: SearchFeatures flags of the techniques to use
+// @return: None
+void ChessAI::setSearchFeatures(int features)
+{
+    searchFeatures = features;
+}
+
+// @purpose: Sets how far outside of the alpha-beta window the cheap terms of the evaluation must be
+//           for the expensive terms to be skipped, when LAZY_EVALUATION is turned on
+// @parameters: Margin in centipawns
+// @return: None
+void ChessAI::setLazyMargin(int margin)
+{
+    lazyMargin = margin;
+}
+
+// @purpose: Get the number of nodes searched by the last search
+// @parameters: None
+// @return: Nodes of the main and quiescence searches of every thread
+int ChessAI::getNodesSearched()
+{
+    return nodesSearched + quiescenceNodesSearched;
+}
+
+// @purpose: Get the statistics of the last search
+// @parameters: None
+// @return: Re-search and fail high counts of every thread
+ChessAI::SearchStats ChessAI::getSearchStats()
+{
+    return stats;
 }
 
 // @purpose: Get the Best move for a given color
@@ -54,112 +209,150 @@ Move ChessAI::getBestMove(Board* boardIn, Colors color)
 
     // Store the best possible move
     pvNode bestPath;
-    pvNode tmpNode;
-
-    // Initial Alpha and Beta Values
-    int alpha = INT_MIN;
-    int beta = INT_MAX;
 
-    // Print out the evaluation of the current position
-    Logger::log("Current Eval: %i\n", evaluateBoard());
+    // Print out the evaluation of the current position - positive is good for White
+    Logger::log("Current Eval: %i\n", evaluateBoard() * ScoreModifier[board->getFen()->activeColor]);
 
     // Disable all print Statements while searching
     Logger::disable();
 
-    // Time the execution
-    time_t start;
-    time_t stop;
-    time(&start);
+    // Time the execution, and decide how long this move can take
+    searchStart = std::chrono::steady_clock::now();
+    calculateTimeLimits();
+    stopSearch = false;
+    completedDepth = 0;
+    nodesSearched = 0;
+    quiescenceNodesSearched = 0;
+    stats = SearchStats();
+    uint64_t pawnProbes = pawnTable.getProbes();
+    uint64_t pawnHits = pawnTable.getHits();
 
-    // Evaluate for the Maximizing Player (White)
-    if (color == WHITE)
-    {
-        int maxEvaluation = INT_MIN;
-        int currentEvaluation = INT_MIN;
-        // Get all of Whites moves
-        mvVector allMoves = *board->getAllMoves(WHITE);
-        moveOrdering(&allMoves);
+    // Entries from the last search are kept, but are replaced before any from this search
+    transpositionTable->newSearch();
 
-        // Loop through all possible moves for White
-        for (mvVector::iterator it = allMoves.begin(); it != allMoves.end(); ++it)
-        {
-            // Make a candiate move
-            board->makeMove(*it);
+    // Killers only apply to the position they were found in, but the history of older searches is still useful
+    clearKillers();
+    ageHistory();
 
-            // evaluate the results of that move
-            tmpNode = miniMax(board->getMoveHistory()->back(), DEPTH - 1, alpha, beta, BLACK);
-            currentEvaluation = tmpNode.eval;
-            // Undo the move
-            board->undoMove();
+    // Start the helper threads - each searches its own copy of the board, and they only share the Transposition Table
+    std::vector<std::thread> threads;
+    for (std::vector<ChessAI*>::iterator it = helpers.begin(); it != helpers.end(); ++it)
+    {
+        (*it)->board = new Board(*board);
+        (*it)->lastPV = lastPV;
+        (*it)->searchFeatures = searchFeatures;
+        (*it)->lazyMargin = lazyMargin;
+        (*it)->nodesSearched = 0;
+        (*it)->quiescenceNodesSearched = 0;
+        (*it)->stats = SearchStats();
+        (*it)->stopSearch = false;
+        threads.push_back(std::thread(&ChessAI::searchHelper, *it));
+    }
 
-            if (currentEvaluation > maxEvaluation)
-            {
-                bestPath.eval = currentEvaluation;
-                bestPath.variation = tmpNode.variation;
+    // A timed search goes as deep as the time allows
+    int maxDepth = (hardLimit > 0) ? MaxDepth : DEPTH;
 
-                maxEvaluation = currentEvaluation;
-            }
-            if (currentEvaluation > alpha)
+    // Search one ply deeper each iteration - the Transposition Table and PV of each iteration order the next one
+    for (int depth = 1; depth <= maxDepth; ++depth)
+    {
+        // Aspiration Windows - expect the score to be close to the last iteration's, and search a narrow window around it
+        // A score outside of the window is only a bound, so the window is widened on that side and searched again
+        // https://www.chessprogramming.org/Aspiration_Windows
+        int alpha = -INFINITE_SCORE;
+        int beta = INFINITE_SCORE;
+        int window = AspirationWindow;
+        if (depth >= AspirationMinDepth)
+        {
+            alpha = bestPath.eval - window;
+            beta = bestPath.eval + window;
+        }
+
+        pvNode result = searchRoot(depth, alpha, beta);
+        while (!stopSearch && (result.eval <= alpha || result.eval >= beta))
+        {
+            ++stats.aspirationResearches;
+            window *= 2;
+            if (result.eval <= alpha)
             {
-                alpha = currentEvaluation;
+                alpha = std::max(result.eval - window, -INFINITE_SCORE);
             }
-            if (beta <= alpha)
+            else
             {
-                break;
+                beta = std::min(result.eval + window, INFINITE_SCORE);
             }
+
+            result = searchRoot(depth, alpha, beta);
         }
-    }
-    // Evaluate the Minimizing Player (Black)
-    else
-    {
-        int minEvaluation = INT_MAX;
-        int currentEvaluation = INT_MAX;
-        // Get all of Blacks moves
-        mvVector allMoves = *board->getAllMoves(BLACK);
-        moveOrdering(&allMoves);
 
-        // Loop through all possible moves for Black
-        for (mvVector::iterator it = allMoves.begin(); it != allMoves.end(); ++it)
+        // An iteration that ran out of time is thrown away, the last completed one is used
+        if (stopSearch)
         {
-            // Make a candiate move
-            board->makeMove(*it);
-
-            // evaluate the results of that move
-            tmpNode = miniMax(board->getMoveHistory()->back(), DEPTH - 1, alpha, beta, WHITE);
-            currentEvaluation = tmpNode.eval;
-
-            // Undo the move
-            board->undoMove();
+            break;
+        }
 
-            if (currentEvaluation < minEvaluation)
-            {
-                bestPath.eval = currentEvaluation;
-                bestPath.variation = tmpNode.variation;
+        bestPath = result;
+        completedDepth = depth;
+        lastPV = bestPath.variation;
 
-                minEvaluation = currentEvaluation;
-            }
-            if (currentEvaluation < beta)
-            {
-                beta = currentEvaluation;
-            }
-            if (beta <= alpha)
-            {
-                break;
-            }
+        // Do not start another iteration that is unlikely to finish in time
+        if (softLimit > 0 && getElapsedTime() >= softLimit)
+        {
+            break;
         }
     }
 
+    // Stop the helper threads, and count their nodes with the main search
+    for (std::vector<ChessAI*>::iterator it = helpers.begin(); it != helpers.end(); ++it)
+    {
+        (*it)->stopSearch = true;
+    }
+    for (std::vector<std::thread>::iterator it = threads.begin(); it != threads.end(); ++it)
+    {
+        it->join();
+    }
+    for (std::vector<ChessAI*>::iterator it = helpers.begin(); it != helpers.end(); ++it)
+    {
+        nodesSearched += (*it)->nodesSearched;
+        quiescenceNodesSearched += (*it)->quiescenceNodesSearched;
+        stats.pvsResearches += (*it)->stats.pvsResearches;
+        stats.reductionResearches += (*it)->stats.reductionResearches;
+        stats.failHighs += (*it)->stats.failHighs;
+        stats.firstMoveFailHighs += (*it)->stats.firstMoveFailHighs;
+        stats.evaluations += (*it)->stats.evaluations;
+        stats.lazyEvaluations += (*it)->stats.lazyEvaluations;
+        stats.evalCacheHits += (*it)->stats.evalCacheHits;
+        stats.evalCacheMisses += (*it)->stats.evalCacheMisses;
+        delete (*it)->board;
+        (*it)->board = 0;
+    }
+
     // Return the Best move
-    time(&stop);
-    int execution = difftime(stop, start);
-    int mins = execution / 60;
-    int secs = execution % 60;
+    int execution = getElapsedTime();
+    int mins = execution / 60000;
+    int secs = (execution / 1000) % 60;
+    int millis = execution % 1000;
 
     // Re-enable the Logger and print best move and PV information
     Logger::enable();
-    Logger::log("Searched %i Nodes in %i min %i sec\n", nodesSearched, mins, secs);
+    int totalNodes = nodesSearched + quiescenceNodesSearched;
+    Logger::log("Searched %i Nodes to depth %i in %i min %i.%03i sec\n", totalNodes, completedDepth, mins, secs, millis);
+    Logger::log("Main Search: %i Nodes, Quiescence Search: %i Nodes (%i%%)\n",
+        nodesSearched, quiescenceNodesSearched, (totalNodes > 0) ? (int)(100LL * quiescenceNodesSearched / totalNodes) : 0);
+    Logger::log("Re-searches: %i Aspiration, %i PVS, %i Reduction - First move fail highs: %i/%i (%i%%)\n",
+        stats.aspirationResearches, stats.pvsResearches, stats.reductionResearches, stats.firstMoveFailHighs, stats.failHighs,
+        (stats.failHighs > 0) ? (int)(100LL * stats.firstMoveFailHighs / stats.failHighs) : 0);
+    Logger::log("Lazy Evaluations: %i/%i (%i%%)\n", stats.lazyEvaluations, stats.evaluations,
+        (stats.evaluations > 0) ? (int)(100LL * stats.lazyEvaluations / stats.evaluations) : 0);
+    int evalCacheProbes = stats.evalCacheHits + stats.evalCacheMisses;
+    Logger::log("Evaluation Cache hits: %i/%i (%i%%)\n", stats.evalCacheHits, evalCacheProbes,
+        (evalCacheProbes > 0) ? (int)(100LL * stats.evalCacheHits / evalCacheProbes) : 0);
+    pawnProbes = pawnTable.getProbes() - pawnProbes;
+    pawnHits = pawnTable.getHits() - pawnHits;
+    Logger::log("Pawn Hash Table hits: %llu/%llu (%i%%)\n", (unsigned long long)pawnHits, (unsigned long long)pawnProbes,
+        (pawnProbes > 0) ? (int)(100 * pawnHits / pawnProbes) : 0);
     Logger::log("The best move I found was ");
-    bestPath.variation.front().printMove(true);
+    Move bestMove = board->createMove(bestPath.variation[0]);
+    bestMove.printMove(true);
     Logger::log("The principal variation I found was ");
     if (color == BLACK)
     {
@@ -167,355 +360,888 @@ Move ChessAI::getBestMove(Board* boardIn, Colors color)
     }
     lastPV.clear();
     
-    // Traverse the Principal Variation
-    for (mvVector::iterator it = bestPath.variation.begin();
+    // Traverse the Principal Variation - playing each move so that it prints as it would in the game
+    for (MoveList::iterator it = bestPath.variation.begin();
         it != bestPath.variation.end();
         ++it)
     {
-        it->printMove(false);
+        board->makeMove(board->createMove(*it));
+        board->getMoveHistory()->back().printMove(false);
 
         // Save the PV for move ordering next turn
-        lastPV.push_back(*it);
+        lastPV.add(*it);
+    }
+    for (int i = 0; i < bestPath.variation.size(); ++i)
+    {
+        board->undoMove();
     }
     Logger::log("\n\n");
 
-    // Reset all turn based variables
-    nodesSearched = 0;
-
     // Return the best move that was found
-    return bestPath.variation.front();
+    return bestMove;
 }
 
-// @purpose: Calculate the move score recursively using the MiniMax algorithm with AlphaBeta Pruning
-// @parameters: int depth to search, Color to represent Min(Black) and Max(White)
-// @return: score of board after N moves
-ChessAI::pvNode ChessAI::miniMax(Move moveBefore, int depth, int alpha, int beta, Colors color)
+// @purpose: Searches every move of the root position to one depth
+// @parameters: Depth to search, alpha and beta of the aspiration window
+// @return: Node of the best move and it's evaluation for the side to move - only a bound if outside of the window
+ChessAI::pvNode ChessAI::searchRoot(int depth, int alpha, int beta)
 {
-    pvNode myNode;
+    // Store the best possible move
+    pvNode bestPath;
 
-    // Track how many nodes are being searched
-    ++nodesSearched;
+    // Save the window to tell how the final score bounds the true score
+    int originalAlpha = alpha;
+    int maxEvaluation = -INFINITE_SCORE;
+    int currentEvaluation = -INFINITE_SCORE;
+
+    // The root is ply 0 of the PV Table
+    pvLength[0] = 0;
+    rootDepth = depth;
 
-    // If we have reached a terminal node, evaluate the board
-    if (depth <= 0 || board->getGameStatus() != IN_PROGRESS)
+    // Search the best move from the last iteration first
+    PackedMove ttMove;
+    TranspositionTable::Entry entry;
+    if (transpositionTable->probe(board->getHash(), entry))
     {
-        myNode.eval = evaluateBoard();
-        myNode.variation.push_back(moveBefore);
-        return myNode;
+        ttMove = entry.move;
     }
 
-    pvNode tmpNode;
+    // Get all of the moves of the side to move, and score them for ordering
+    MoveList allMoves = *board->getAllMoves(board->getFen()->activeColor);
+    int scores[MoveList::MaxMoves];
+    scoreMoves(allMoves, scores, ttMove, 0);
 
-    // Evaluate for the Maximizing Player (White)
-    if (color == WHITE)
+    // Loop through all possible moves, best scored first
+    for (int i = 0; i < allMoves.size(); ++i)
     {
-        int maxEvaluation = INT_MIN;
-        int currentEvaluation = INT_MIN;
-        // Get all of Whites moves
-        mvVector allMoves = *board->getAllMoves(WHITE);
-        moveOrdering(&allMoves);
+        PackedMove move = pickMove(allMoves, scores, i);
 
-        // Loop through all possible moves for White
-        for (mvVector::iterator it = allMoves.begin(); it != allMoves.end(); ++it)
+        // Make a candiate move
+        board->makeMove(move);
+
+        // evaluate the results of that move - the opponent's score is the negative of ours
+        // Like every other node, only the first move is searched with the full window
+        if (i == 0)
+        {
+            currentEvaluation = -negaMax(depth - 1, 1, -beta, -alpha, true);
+        }
+        else
         {
-            // Make a candiate move
-            board->makeMove(*it);
+            currentEvaluation = -negaMax(depth - 1, 1, -alpha - 1, -alpha, true);
+            if (currentEvaluation > alpha && currentEvaluation < beta && !stopSearch)
+            {
+                ++stats.pvsResearches;
+                currentEvaluation = -negaMax(depth - 1, 1, -beta, -alpha, true);
+            }
+        }
 
-            // evaluate the results of that move
-            tmpNode = miniMax(board->getMoveHistory()->back(), depth - 1, alpha, beta, BLACK);
-            currentEvaluation = tmpNode.eval;
+        // Undo the move
+        board->undoMove();
 
-            // Undo the move
-            board->undoMove();
+        // The score of an unfinished search can not be trusted
+        if (stopSearch)
+        {
+            return bestPath;
+        }
 
-            if (currentEvaluation > maxEvaluation)
-            {
-                myNode.eval = currentEvaluation;
-                myNode.variation.clear();
-                myNode.variation.push_back(moveBefore);
-                myNode.variation.insert(myNode.variation.end(),
-                    tmpNode.variation.begin(),
-                    tmpNode.variation.end());
-
-                maxEvaluation = currentEvaluation;
-            }
-            if (currentEvaluation > alpha)
-            {
-                alpha = currentEvaluation;
-            }
-            if (beta <= alpha)
+        if (currentEvaluation > maxEvaluation)
+        {
+            bestPath.eval = currentEvaluation;
+            updatePV(0, move);
+
+            maxEvaluation = currentEvaluation;
+        }
+        if (currentEvaluation > alpha)
+        {
+            alpha = currentEvaluation;
+        }
+        if (beta <= alpha)
+        {
+            // Above the aspiration window - the caller searches again with a wider one
+            ++stats.failHighs;
+            if (i == 0)
             {
-                break;
+                ++stats.firstMoveFailHighs;
             }
+            break;
         }
-        return myNode;
     }
-    // Evaluate the Minimizing Player (Black)
-    else
-    {
-        int minEvaluation = INT_MAX;
-        int currentEvaluation = INT_MAX;
-        // Get all of Whites moves
-        mvVector allMoves = *board->getAllMoves(BLACK);
-        moveOrdering(&allMoves);
 
-        // Loop through all possible moves for Black
-        for (mvVector::iterator it = allMoves.begin(); it != allMoves.end(); ++it)
-        {
-            // Make a candiate move
-            board->makeMove(*it);
+    // Copy the finished PV out of the PV Table
+    for (int i = 0; i < pvLength[0]; ++i)
+    {
+        bestPath.variation.add(pvTable[0][i]);
+    }
 
-            // evaluate the results of that move
-            tmpNode = miniMax(board->getMoveHistory()->back(), depth - 1, alpha, beta, WHITE);
-            currentEvaluation = tmpNode.eval;
+    // Save the result of the whole search for the next iteration - scores outside of the window only bound the true score
+    TranspositionTable::Bounds bound = TranspositionTable::BOUND_EXACT;
+    if (bestPath.eval <= originalAlpha)
+    {
+        bound = TranspositionTable::BOUND_UPPER;
+    }
+    else if (bestPath.eval >= beta)
+    {
+        bound = TranspositionTable::BOUND_LOWER;
+    }
+    transpositionTable->store(board->getHash(), depth, bestPath.eval, bound, bestPath.variation[0]);
 
-            // Undo the move
-            board->undoMove();
+    return bestPath;
+}
 
-            if (currentEvaluation < minEvaluation)
-            {
-                myNode.eval = currentEvaluation;
-                myNode.variation.clear();
-                myNode.variation.push_back(moveBefore);
-                myNode.variation.insert(myNode.variation.end(), 
-                    tmpNode.variation.begin(), 
-                    tmpNode.variation.end());
-
-                minEvaluation = currentEvaluation;
-            }
-            if (currentEvaluation < beta)
-            {
-                beta = currentEvaluation;
-            }
-            if (beta <= alpha)
-            {
-                break;
-            }
-        }
-        return myNode;
+// @purpose: Searches the root position until stopped by the main thread, to fill the shared Transposition Table
+// @parameters: None
+// @return: None
+void ChessAI::searchHelper()
+{
+    // Half of the helpers start a ply deeper, so that the threads are spread over more depths
+    for (int depth = 1 + (threadId % 2); depth <= MaxDepth && !stopSearch; ++depth)
+    {
+        searchRoot(depth, -INFINITE_SCORE, INFINITE_SCORE);
     }
 }
 
-// @purpose: Calculate the move score recursively using the MiniMax algorithm with AlphaBeta Pruning
-// @parameters: int depth to search, Color to represent Min(Black) and Max(White)
-// @return: score of board after N moves
-int ChessAI::miniMax(int depth, int alpha, int beta, Colors color)
+// @purpose: Calculate the move score recursively using Negamax with AlphaBeta Pruning and Principal Variation Search
+// @parameters: depth to search, distance from the root, alpha and beta for the side to move, if a null move may be tried
+// @return: Evaluation of the position for the side to move - the best line is left in the PV Table at this ply
+int ChessAI::negaMax(int depth, int ply, int alpha, int beta, bool allowNullMove)
 {
+    // At the end of the main search, only search captures until the position is quiet
+    if (depth <= 0)
+    {
+        return quiescence(ply, alpha, beta);
+    }
+
     // Track how many nodes are being searched
     ++nodesSearched;
 
-    // Check if the game is over
-    GameResults result = board->getGameStatus();
+    // No line has been found from this node yet
+    pvLength[ply] = ply;
+
+    // Check the clock every so often, and stop the search once it runs out
+    if ((nodesSearched & TimeCheckNodes) == 0)
+    {
+        checkTime();
+    }
+    if (stopSearch)
+    {
+        return 0;
+    }
+
+    // If the game is over, evaluate the board
+    if (ply >= MaxPly - 1 || board->getGameStatus() != IN_PROGRESS)
+    {
+        return mateDistanceScore(evaluateBoard(), ply);
+    }
+
+    // Check if this position has already been searched deep enough to know its score
+    ZobristKey key = board->getHash();
+    PackedMove ttMove;
+    TranspositionTable::Entry entry;
+    if (transpositionTable->probe(key, entry))
+    {
+        ttMove = entry.move;
+        entry.score = mateTableScore(entry.score, -ply);
+
+        if (entry.depth >= depth &&
+            (entry.bound == TranspositionTable::BOUND_EXACT ||
+            (entry.bound == TranspositionTable::BOUND_LOWER && entry.score >= beta) ||
+            (entry.bound == TranspositionTable::BOUND_UPPER && entry.score <= alpha)))
+        {
+            return entry.score;
+        }
+    }
+
+    Colors activeColor = board->getFen()->activeColor;
+    bool inCheck = board->isInCheck(activeColor);
+
+    // Only a null window node can be pruned - a PV node needs its exact score
+    bool isPvNode = (beta - alpha > 1);
+
+    // The selective search decides what to prune from the evaluation of the position itself
+    int staticEval = -INFINITE_SCORE;
+    if (!isPvNode && !inCheck)
+    {
+        staticEval = evaluateBoard(alpha, beta);
+    }
 
-    // If we have reached a terminal node, evaluate the board
-    if (depth <= 0 || result != IN_PROGRESS)
+    // Reverse Futility Pruning - so far above beta that no move this close to the leaves will bring it back down
+    // https://www.chessprogramming.org/Reverse_Futility_Pruning
+    if ((searchFeatures & REVERSE_FUTILITY_PRUNING) && !isPvNode && !inCheck &&
+        depth <= ReverseFutilityDepth && staticEval - ReverseFutilityMargin * depth >= beta)
     {
-        return evaluateBoard();
+        return staticEval - ReverseFutilityMargin * depth;
     }
 
-    // Evaluate for the Maximizing Player (White)
-    if (color == WHITE)
+    // Null Move Pruning - if passing still fails high, a real move would too
+    // Not tried without pieces, where passing could be better than any move (Zugzwang)
+    // https://www.chessprogramming.org/Null_Move_Pruning
+    if ((searchFeatures & NULL_MOVE_PRUNING) && allowNullMove && !isPvNode && !inCheck &&
+        depth >= NullMoveMinDepth && staticEval >= beta &&
+        (board->getOccupancy(activeColor) & ~(board->getPieces(activeColor, PAWN) | board->getPieces(activeColor, KING))))
     {
-        int maxEvaluation = INT_MIN;
-        int currentEvaluation = INT_MIN;
-        // Get all of Whites moves
-        mvVector allMoves = *board->getAllMoves(WHITE);
-        moveOrdering(&allMoves);
+        // Adaptive Null Move - reduce deeper searches by more
+        int reduction = (depth > NullMoveDeepDepth) ? 3 : 2;
 
-        // Loop through all possible moves for White
-        for (mvVector::iterator it = allMoves.begin(); it != allMoves.end(); ++it)
+        board->makeNullMove();
+        int nullEvaluation = -negaMax(depth - 1 - reduction, ply + 1, -beta, -beta + 1, false);
+        board->undoNullMove();
+
+        if (stopSearch)
+        {
+            return 0;
+        }
+        if (nullEvaluation >= beta)
         {
-            // Make a candiate move
-            board->makeMove(*it);
-            Move lastmove = board->getMoveHistory()->back();
+            return beta;
+        }
+    }
+
+    // Futility Pruning - at the frontier, a quiet move can not raise a score this far below alpha
+    // https://www.chessprogramming.org/Futility_Pruning
+    bool futile = (searchFeatures & FUTILITY_PRUNING) && !isPvNode && !inCheck &&
+        depth <= FutilityDepth && staticEval + FutilityMargin * depth <= alpha;
+
+    // Save the window to tell how the final score bounds the true score
+    int originalAlpha = alpha;
+    PackedMove bestMove;
 
-            // evaluate the results of that move
-            currentEvaluation = miniMax(depth - 1, alpha, beta, BLACK);
-            // Undo the move
+    int maxEvaluation = -INFINITE_SCORE;
+    int currentEvaluation = -INFINITE_SCORE;
+
+    // Get all of the moves of the side to move, and score them for ordering
+    MoveList allMoves = *board->getAllMoves(activeColor);
+    int scores[MoveList::MaxMoves];
+    scoreMoves(allMoves, scores, ttMove, ply);
+
+    // Loop through all possible moves, best scored first
+    for (int i = 0; i < allMoves.size(); ++i)
+    {
+        PackedMove move = pickMove(allMoves, scores, i);
+        bool quiet = !move.isCapture() && !move.isPromotion();
+
+        // Make a candiate move
+        board->makeMove(move);
+        bool givesCheck = board->isInCheck(board->getFen()->activeColor);
+
+        // Skip a futile quiet move, unless it gives check - the first move is always searched
+        if (futile && quiet && !givesCheck && i > 0)
+        {
             board->undoMove();
+            if (maxEvaluation < staticEval + FutilityMargin * depth)
+            {
+                maxEvaluation = staticEval + FutilityMargin * depth;
+            }
+            continue;
+        }
 
-            if (currentEvaluation > maxEvaluation)
+        // Check Extension - search a checking move a ply deeper, so that the reply is not cut off at the horizon
+        int newDepth = depth - 1;
+        if ((searchFeatures & CHECK_EXTENSIONS) && givesCheck && ply < 2 * rootDepth)
+        {
+            ++newDepth;
+        }
+
+        // evaluate the results of that move - the opponent's score is the negative of ours
+        // The first move is expected to be the best, so the rest are searched with a null window
+        // only to prove that they are worse, and searched again with the full window if they are not
+        if (i == 0)
+        {
+            currentEvaluation = -negaMax(newDepth, ply + 1, -beta, -alpha, true);
+        }
+        else
+        {
+            // Late Move Reductions - quiet moves ordered late are unlikely to be best, so search them shallower
+            // A move that beats alpha anyway is searched again at the full depth
+            // https://www.chessprogramming.org/Late_Move_Reductions
+            int reduction = 0;
+            if ((searchFeatures & LATE_MOVE_REDUCTIONS) && quiet && !inCheck && !givesCheck &&
+                depth >= LateMoveMinDepth && i >= LateMoveIndex)
             {
-                maxEvaluation = currentEvaluation;
+                reduction = (i >= 2 * LateMoveIndex && depth > LateMoveMinDepth) ? 2 : 1;
             }
-            if (currentEvaluation > alpha)
+
+            currentEvaluation = -negaMax(newDepth - reduction, ply + 1, -alpha - 1, -alpha, true);
+            if (reduction > 0 && currentEvaluation > alpha && !stopSearch)
             {
-                alpha = currentEvaluation;
+                ++stats.reductionResearches;
+                currentEvaluation = -negaMax(newDepth, ply + 1, -alpha - 1, -alpha, true);
             }
-            if (beta <= alpha)
+            if (currentEvaluation > alpha && currentEvaluation < beta && !stopSearch)
             {
-                break;
+                ++stats.pvsResearches;
+                currentEvaluation = -negaMax(newDepth, ply + 1, -beta, -alpha, true);
             }
         }
-        return maxEvaluation;
-    }
-    // Evaluate the Minimizing Player (Black)
-    else
-    {
-        int minEvaluation = INT_MAX;
-        int currentEvaluation = INT_MAX;
-        // Get all of Whites moves
-        mvVector allMoves = *board->getAllMoves(BLACK);
-        moveOrdering(&allMoves);
 
-        // Loop through all possible moves for White
-        for (mvVector::iterator it = allMoves.begin(); it != allMoves.end(); ++it)
+        // Undo the move
+        board->undoMove();
+
+        // The score of an unfinished search can not be trusted
+        if (stopSearch)
         {
-            // Make a candiate move
-            board->makeMove(*it);
-            Move lastmove = board->getMoveHistory()->back();
+            return 0;
+        }
 
-            // evaluate the results of that move
-            currentEvaluation = miniMax(depth - 1, alpha, beta, WHITE);
-            // Undo the move
-            board->undoMove();
+        if (currentEvaluation > maxEvaluation)
+        {
+            updatePV(ply, move);
 
-            if (currentEvaluation < minEvaluation)
-            {
-                minEvaluation = currentEvaluation;
-            }
-            if (currentEvaluation < beta)
+            maxEvaluation = currentEvaluation;
+            bestMove = move;
+        }
+        if (currentEvaluation > alpha)
+        {
+            alpha = currentEvaluation;
+        }
+        if (beta <= alpha)
+        {
+            // Count how often the first move is enough, to measure the move ordering
+            ++stats.failHighs;
+            if (i == 0)
             {
-                beta = currentEvaluation;
+                ++stats.firstMoveFailHighs;
             }
-            if (beta <= alpha)
+
+            // Remember a quiet move that refutes this position, to try it early in its siblings
+            if (quiet)
             {
-                break;
+                updateKillers(move, ply, depth, activeColor);
             }
+            break;
         }
-        return minEvaluation;
     }
+
+    // Save the result - scores outside of the window only bound the true score
+    TranspositionTable::Bounds bound = TranspositionTable::BOUND_EXACT;
+    if (maxEvaluation <= originalAlpha)
+    {
+        bound = TranspositionTable::BOUND_UPPER;
+    }
+    else if (maxEvaluation >= beta)
+    {
+        bound = TranspositionTable::BOUND_LOWER;
+    }
+    transpositionTable->store(key, depth, mateTableScore(maxEvaluation, ply), bound, bestMove);
+
+    return maxEvaluation;
 }
 
-// @purpose: Orders the moves for a best-first search
-// @parameters: List of moves to order
+// @purpose: Makes a move the start of the best line from a ply, followed by the best line found after it
+// @parameters: Distance from the root, Move that is now the best
 // @return: None
-void ChessAI::moveOrdering(mvVector* moves)
+void ChessAI::updatePV(int ply, PackedMove move)
+{
+    pvTable[ply][ply] = move;
+    for (int i = ply + 1; i < pvLength[ply + 1]; ++i)
+    {
+        pvTable[ply][i] = pvTable[ply + 1][i];
+    }
+    pvLength[ply] = pvLength[ply + 1];
+}
+
+// @purpose: Searches captures and promotions until the position is quiet, so that a leaf is not evaluated mid-exchange
+// @parameters: distance from the root, alpha and beta for the side to move
+// @return: Evaluation of the position for the side to move - the best line is left in the PV Table at this ply
+int ChessAI::quiescence(int ply, int alpha, int beta)
 {
-    if (moves->empty()) return;
+    // Track how many nodes are being searched, separately from the main search
+    ++quiescenceNodesSearched;
 
-    Colors activeColor = moves->front().pieceMoved->getColor();
+    // No line has been found from this node yet
+    pvLength[ply] = ply;
 
-    // Search the most advanced pieces first
-    // If the pieces are White, search from the top of the board down
-    // Moves are currently generated from A8 -> H1 so no change needed for white
+    // Check the clock every so often, and stop the search once it runs out
+    if ((quiescenceNodesSearched & TimeCheckNodes) == 0)
+    {
+        checkTime();
+    }
+    if (stopSearch)
+    {
+        return 0;
+    }
+
+    // If the game is over, or the search is too deep, evaluate the board
+    if (ply >= MaxPly - 1 || board->getGameStatus() != IN_PROGRESS)
+    {
+        return mateDistanceScore(evaluateBoard(), ply);
+    }
+
+    Colors activeColor = board->getFen()->activeColor;
+    bool inCheck = board->isInCheck(activeColor);
+
+    // Stand Pat - the side to move does not have to capture, so the evaluation is a lower bound
+    // A King in check must get out of it, so every move is searched instead
+    int standPat = -INFINITE_SCORE;
+    if (!inCheck)
+    {
+        standPat = evaluateBoard(alpha, beta);
+        if (standPat >= beta)
+        {
+            return standPat;
+        }
+        if (standPat > alpha)
+        {
+            alpha = standPat;
+        }
+    }
+    int maxEvaluation = standPat;
+    int currentEvaluation = -INFINITE_SCORE;
 
-    // If the pieces are Black, search from the bottom of the board up
-    if (activeColor == BLACK)
+    // Keep only the captures and promotions
+    MoveList* allMoves = board->getAllMoves(activeColor);
+    MoveList moves;
+    for (MoveList::iterator it = allMoves->begin(); it != allMoves->end(); ++it)
     {
-        std::reverse(moves->begin(), moves->end());
+        if (!inCheck && !it->isCapture() && !it->isPromotion())
+        {
+            continue;
+        }
+
+        // Delta Pruning - skip a capture that can not raise the score to alpha even with a margin to spare
+        if (!inCheck && standPat + getCaptureGain(*it) + DELTA_MARGIN <= alpha)
+        {
+            continue;
+        }
+
+        moves.add(*it);
     }
+    int scores[MoveList::MaxMoves];
+    scoreMoves(moves, scores, PackedMove(), ply);
 
-    // Prioritize moves that were in the last PV
-    mvVector pvMoves;
-    for (mvVector::iterator it = lastPV.begin(); it != lastPV.end(); ++it)
+    // Loop through the moves, best scored first
+    for (int i = 0; i < moves.size(); ++i)
     {
-        mvVector::iterator jt = std::find(moves->begin(), moves->end(), *it);
-        if (jt != moves->end())
+        PackedMove move = pickMove(moves, scores, i);
+
+        // Make a candiate move
+        board->makeMove(move);
+
+        // evaluate the results of that move - the opponent's score is the negative of ours
+        currentEvaluation = -quiescence(ply + 1, -beta, -alpha);
+
+        // Undo the move
+        board->undoMove();
+
+        // The score of an unfinished search can not be trusted
+        if (stopSearch)
+        {
+            return 0;
+        }
+
+        if (currentEvaluation > maxEvaluation)
+        {
+            updatePV(ply, move);
+
+            maxEvaluation = currentEvaluation;
+        }
+        if (currentEvaluation > alpha)
+        {
+            alpha = currentEvaluation;
+        }
+        if (beta <= alpha)
         {
-            pvMoves.push_back(*jt);
-            moves->erase(jt);
+            break;
         }
     }
 
-    moves->insert(moves->begin(), pvMoves.begin(), pvMoves.end());
+    return maxEvaluation;
+}
+
+// @purpose: Scores a win or loss only by its distance from the root, so that the quickest win and the slowest
+//           loss are preferred - the material left when the game ends would otherwise outweigh the distance
+// @parameters: Evaluation of a position, distance from the root
+// @return: Evaluation adjusted for the distance
+int ChessAI::mateDistanceScore(int score, int ply)
+{
+    if (score > WIN_BOUND)
+    {
+        return WIN_SCORE - ply;
+    }
+    if (score < -WIN_BOUND)
+    {
+        return -WIN_SCORE + ply;
+    }
+    return score;
+}
+
+// @purpose: Converts a score between the distance from the root and the distance from the position, since
+//           the Transposition Table may return a win or loss at a different distance from the root than it was stored
+// @parameters: Evaluation of a position, distance from the root - negative to convert back from the table
+// @return: Evaluation with a win or loss counted from the other point
+int ChessAI::mateTableScore(int score, int ply)
+{
+    if (score > WIN_BOUND)
+    {
+        return score + ply;
+    }
+    if (score < -WIN_BOUND)
+    {
+        return score - ply;
+    }
+    return score;
+}
+
+// @purpose: Get the material that a move wins, from the piece it captures and the piece it promotes to
+// @parameters: Move to score
+// @return: Material gained by the move
+int ChessAI::getCaptureGain(PackedMove move)
+{
+    int gain = 0;
+
+    if (move.isEnPassant())
+    {
+        gain += PAWN_SCORE;
+    }
+    else if (move.isCapture())
+    {
+        gain += PieceScores[board->getPieceAt(move.getEnd())->getType()];
+    }
+
+    if (move.isPromotion())
+    {
+        gain += PieceScores[move.getPromotion()] - PAWN_SCORE;
+    }
+
+    return gain;
+}
 
+// @purpose: Scores a capture by Most Valuable Victim - Least Valuable Attacker
+//           https://www.chessprogramming.org/MVV-LVA
+// @parameters: Move to score
+// @return: Higher scores for bigger captures, and for cheaper pieces making the same capture
+int ChessAI::getMvvLvaScore(PackedMove move)
+{
+    // The victim decides the order, the attacker only breaks ties between the same victim
+    return getCaptureGain(move) * NUM_PIECES + (KING - board->getPieceAt(move.getStart())->getType());
 }
 
-// @purpose: Calculate the score for a given board
+// @purpose: Decides how long the current search can take from the time limits
 // @parameters: None
-// @return: score for the position
-int ChessAI::evaluateBoard()
+// @return: None
+void ChessAI::calculateTimeLimits()
 {
-    int score = 0;
+    softLimit = 0;
+    hardLimit = 0;
 
-    // realtive scores - return Negative for black, positive for white
-    score = calculateMaterialScore();
-    score += calculateProtectionScore();
-    score += calculateCheckScore();
-    score += calculateEndgameScore();
+    if (moveTime > 0)
+    {
+        // Use all of a fixed move time
+        softLimit = moveTime;
+        hardLimit = moveTime;
+    }
+    else if (clockTime > 0)
+    {
+        // Plan to spread the clock over the rest of the game, and use most of the increment
+        softLimit = clockTime / MovesToGo + clockIncrement * 3 / 4;
 
-    return score;
+        // A hard iteration may run longer, but never spend a large part of the clock on one move
+        hardLimit = std::min(softLimit * 4, clockTime / 4);
+        softLimit = std::min(softLimit, hardLimit);
+    }
+    else
+    {
+        return;
+    }
+
+    // Leave time to return the move, but always search for some time
+    softLimit = std::max(softLimit - MoveOverhead, 1);
+    hardLimit = std::max(hardLimit - MoveOverhead, 1);
 }
 
-// @purpose: Calculate the Material Score for a position
+// @purpose: Get the time since the search started
 // @parameters: None
-// @return: material score for the position
-int ChessAI::calculateMaterialScore()
+// @return: Elapsed time in milliseconds
+int ChessAI::getElapsedTime()
 {
-    int score = 0;
-    Piece* piece = 0;
+    return (int)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - searchStart).count();
+}
 
-    for (int square = A8; square <= H1; ++square)
+// @purpose: Stops the search if it has reached the hard time limit
+// @parameters: None
+// @return: None
+void ChessAI::checkTime()
+{
+    // The first iteration always finishes, so that there is a move to play
+    if (hardLimit > 0 && completedDepth > 0 && getElapsedTime() >= hardLimit)
     {
-        piece = board->getPieceAt((Squares)square);
+        stopSearch = true;
+    }
+}
 
-        if (piece == 0) continue;
+// @purpose: Scores the moves for a best-first search - https://www.chessprogramming.org/Move_Ordering
+//           The hash move is first, then winning and even captures by MVV-LVA, then the killers,
+//           then quiet moves by their history, and losing captures last
+// @parameters: List of moves to score, Scores to fill, Best move from the Transposition Table (null if none), distance from the root
+// @return: None
+void ChessAI::scoreMoves(MoveList& moves, int* scores, PackedMove ttMove, int ply)
+{
+    Colors activeColor = board->getFen()->activeColor;
 
-        // Calcaulte the Score of the piece by the piece score, +/- the PSQT modifier
-        // times the modifier per color (1 for White, -1 for Black)
-        score += ((PieceScores[piece->getType()] + getPsqtModifier(piece))
-                  * ScoreModifier[piece->getColor()]);
+    // Without a hash move, follow the PV of the last search
+    if (ttMove.isNull() && ply < lastPV.size())
+    {
+        ttMove = lastPV[ply];
     }
 
-    return score;
+    for (int i = 0; i < moves.size(); ++i)
+    {
+        PackedMove move = moves[i];
+
+        if (move == ttMove)
+        {
+            scores[i] = HashMoveScore;
+        }
+        else if (move.isCapture() || move.isPromotion())
+        {
+            // Only a capture by a more valuable piece can lose material
+            int attacker = PieceScores[board->getPieceAt(move.getStart())->getType()];
+            bool winning = move.isPromotion() || getCaptureGain(move) >= attacker || getStaticExchange(move) >= 0;
+            scores[i] = (winning ? CaptureScore : BadCaptureScore) + getMvvLvaScore(move);
+        }
+        else if (move == killers[ply][0])
+        {
+            scores[i] = KillerScore;
+        }
+        else if (move == killers[ply][1])
+        {
+            scores[i] = KillerScore - 1;
+        }
+        else
+        {
+            scores[i] = history[activeColor][move.getStart()][move.getEnd()];
+        }
+    }
 }
 
-// @purpose: Get the PIece Square Table Modifier for a given piece
-// @parameters: Pice object to evaluate
-// @return: PSQT Modifier (addition)
-int ChessAI::getPsqtModifier(Piece* piece)
+// @purpose: Moves the best scored of the remaining moves to the front - a lazy selection sort,
+//           so that the moves after a cutoff are never sorted
+// @parameters: List of moves, Scores of the moves, Index of the first remaining move
+// @return: The best remaining move
+PackedMove ChessAI::pickMove(MoveList& moves, int* scores, int index)
 {
-    switch (piece->getType())
+    int best = index;
+    for (int i = index + 1; i < moves.size(); ++i)
     {
-    case PAWN:
-        return PAWN_PSQT[piece->getColor()][piece->getPos()];
+        if (scores[i] > scores[best])
+        {
+            best = i;
+        }
+    }
+    std::swap(moves[index], moves[best]);
+    std::swap(scores[index], scores[best]);
 
-    case KNIGHT:
-        return KNIGHT_PSQT[piece->getColor()][piece->getPos()];
+    return moves[index];
+}
+
+// @purpose: Remembers a quiet move that caused a beta cutoff, in the killers of its ply and the history table
+// @parameters: Move that caused the cutoff, distance from the root, depth searched, Color that made the move
+// @return: None
+void ChessAI::updateKillers(PackedMove move, int ply, int depth, Colors color)
+{
+    if (move != killers[ply][0])
+    {
+        killers[ply][1] = killers[ply][0];
+        killers[ply][0] = move;
+    }
 
-    case BISHOP:
-        return BISHOP_PSQT[piece->getColor()][piece->getPos()];
+    // Deeper cutoffs save more work, so they count for more
+    int& score = history[color][move.getStart()][move.getEnd()];
+    score += depth * depth;
 
-    case ROOK:
-        return ROOK_PSQT[piece->getColor()][piece->getPos()];
+    // Keep the history below the killers, halving every entry when one grows too large
+    if (score >= HistoryMax)
+    {
+        ageHistory();
+    }
+}
 
-    case QUEEN:
-        return QUEEN_PSQT[piece->getColor()][piece->getPos()];
+// @purpose: Removes all killer moves
+// @parameters: None
+// @return: None
+void ChessAI::clearKillers()
+{
+    for (int ply = 0; ply < MaxPly; ++ply)
+    {
+        killers[ply][0] = PackedMove();
+        killers[ply][1] = PackedMove();
+    }
+}
 
-    case KING:
-        if (isEndgame())
+// @purpose: Halves every entry in the history table, so that newer cutoffs count for more than older ones
+// @parameters: None
+// @return: None
+void ChessAI::ageHistory()
+{
+    for (int color = WHITE; color <= BLACK; ++color)
+    {
+        for (int start = A8; start <= H1; ++start)
         {
-            return KING_EG_PSQT[piece->getColor()][piece->getPos()];
+            for (int end = A8; end <= H1; ++end)
+            {
+                history[color][start][end] /= 2;
+            }
         }
-        else
+    }
+}
+
+// @purpose: Calculates the material that a capture wins once every exchange on its square is made
+//           https://www.chessprogramming.org/Static_Exchange_Evaluation
+// @parameters: Capture to evaluate
+// @return: Material won by the side making the capture, negative if it loses material
+int ChessAI::getStaticExchange(PackedMove move)
+{
+    Squares target = move.getEnd();
+    Bitboard occupied = board->getOccupancy();
+    Colors side = board->getPieceAt(move.getStart())->getColor();
+
+    // The gain of each capture in the sequence, if the exchange stopped after it
+    int gain[32];
+    int depth = 0;
+    gain[0] = getCaptureGain(move);
+
+    // The piece that now stands on the square, and can be captured next
+    int pieceOnSquare = PieceScores[board->getPieceAt(move.getStart())->getType()];
+    occupied ^= Bitboards::squareBB(move.getStart());
+    if (move.isEnPassant())
+    {
+        occupied ^= Bitboards::squareBB(target + ((side == WHITE) ? Chess::NumFiles : -Chess::NumFiles));
+    }
+
+    side = Chess::enemy[side];
+    while (depth < 31)
+    {
+        // Removing pieces from occupied reveals the sliders behind them
+        Bitboard attackers = board->getAttackers(target, side, occupied) & occupied;
+        if (!attackers)
         {
-            return KING_MG_PSQT[piece->getColor()][piece->getPos()];
+            break;
         }
 
-    default:
-        return 0;
+        // Always recapture with the least valuable piece
+        PieceTypes type = PAWN;
+        Bitboard typeAttackers = attackers & board->getPieces(side, type);
+        while (!typeAttackers)
+        {
+            type = (PieceTypes)(type + 1);
+            typeAttackers = attackers & board->getPieces(side, type);
+        }
+
+        ++depth;
+        gain[depth] = pieceOnSquare - gain[depth - 1];
+
+        // Neither side can do better by continuing the exchange
+        if (std::max(-gain[depth - 1], gain[depth]) < 0)
+        {
+            break;
+        }
+
+        pieceOnSquare = PieceScores[type];
+        occupied ^= Bitboards::squareBB(Bitboards::lsb(typeAttackers));
+        side = Chess::enemy[side];
+    }
+
+    // Each side may stop the exchange instead of making a capture that loses material
+    while (depth > 0)
+    {
+        gain[depth - 1] = -std::max(-gain[depth - 1], gain[depth]);
+        --depth;
     }
+
+    return gain[0];
 }
 
-// @purpose: Checks if the board is in the endgame
-// @parameters: None
-// @return: true if endgame, false otherwise
-bool ChessAI::isEndgame()
+// @purpose: Calculate the score for a given board - the cheap terms are scored first, and the expensive terms
+//           are skipped when the score is already far enough outside of the window that they can not matter
+//           https://www.chessprogramming.org/Lazy_Evaluation
+// @parameters: alpha and beta for the side to move, the full score is always calculated without them
+// @return: score for the position, from the point of view of the side to move
+int ChessAI::evaluateBoard(int alpha, int beta)
 {
-    // Currently, the definition of 'EndGame' is the absence of queens
-    
-    // Check if there are no more queens on the board
-    for (int i = 0; i < Chess::NumSquares; ++i)
+    int score = 0;
+    int modifier = ScoreModifier[board->getFen()->activeColor];
+    ++stats.evaluations;
+
+    // A finished game can be a draw because of the moves that led to it, which are not part of the key
+    bool cacheable = board->getGameStatus() == IN_PROGRESS;
+    ZobristKey key = board->getHash();
+    const EvaluationCache::Entry* entry = 0;
+    if (cacheable)
+    {
+        entry = evalCache.probe(key);
+        if (entry)
+        {
+            ++stats.evalCacheHits;
+        }
+        else
+        {
+            ++stats.evalCacheMisses;
+        }
+    }
+
+    if (entry)
+    {
+        // A lazy evaluation only has the cheap terms, the expensive terms can still be added to it
+        score = entry->score;
+        if (entry->complete)
+        {
+            return score * modifier;
+        }
+    }
+    else
+    {
+        // realtive scores - return Negative for black, positive for white
+        // The material is kept up to date by the Board, and the Pawns are usually in the Pawn Hash Table
+        score = calculateMaterialScore();
+        score += calculateCheckScore();
+        score += calculatePawnScore();
+        score += calculateEndgameScore();
+    }
+
+    // Mobility needs the moves of both colors and Protection the squares both colors attack, which are found with them
+    // If they can not bring the score back into the window, do not generate them
+    if ((searchFeatures & LAZY_EVALUATION) &&
+        (score * modifier + lazyMargin <= alpha || score * modifier - lazyMargin >= beta))
     {
-        if (board->getCharBoard()[i] == 'Q' ||
-            board->getCharBoard()[i] == 'q')
+        ++stats.lazyEvaluations;
+        if (cacheable && !entry)
         {
-            return false;
+            evalCache.store(key, score, false);
         }
+        return score * modifier;
     }
 
-    return true;
+    score += calculateMobilityScore();
+    score += calculateProtectionScore();
+    if (cacheable)
+    {
+        evalCache.store(key, score, true);
+    }
+
+    // Flip the score for Black, so that a higher score is always better for the side to move
+    return score * modifier;
+}
+
+// @purpose: Calculate the Material Score for a position
+// @parameters: None
+// @return: material score for the position
+int ChessAI::calculateMaterialScore()
+{
+    // The Board keeps the score of each color up to date as the pieces move
+    int middlegame = board->getMaterialScore(WHITE, MIDDLEGAME) - board->getMaterialScore(BLACK, MIDDLEGAME);
+    int endgame = board->getMaterialScore(WHITE, ENDGAME) - board->getMaterialScore(BLACK, ENDGAME);
+
+    return taperScore(middlegame, endgame);
+}
+
+// @purpose: Blends a middlegame and an endgame score by the phase of the game
+// @parameters: Middlegame score, Endgame score
+// @return: Score weighted towards the middlegame by the material left on the board
+int ChessAI::taperScore(int middlegame, int endgame)
+{
+    // Promotions can add more material than the game started with
+    int phase = std::min(board->getPhase(), TOTAL_PHASE);
+
+    return (middlegame * phase + endgame * (TOTAL_PHASE - phase)) / TOTAL_PHASE;
 }
 
 // @purpose: Calculate the Mobility Score for a position
@@ -526,7 +1252,9 @@ int ChessAI::calculateMobilityScore()
     int whiteMobility = board->getAllMoves(WHITE)->size();
     int blackMobility = board->getAllMoves(BLACK)->size();
 
-    return (whiteMobility - blackMobility) * MOBILITY_SCORE;
+    int mobility = whiteMobility - blackMobility;
+
+    return taperScore(mobility * MOBILITY_SCORE[MIDDLEGAME], mobility * MOBILITY_SCORE[ENDGAME]);
 }
 
 // @purpose: Calculate the Protection Score for a position
@@ -534,8 +1262,14 @@ int ChessAI::calculateMobilityScore()
 // @return: Protection score for the position
 int ChessAI::calculateProtectionScore()
 {
-    // TODO - Check for friendly pieces in the move list
-    return 0;
+    // Count the pieces that another piece of their color protects - the Kings can not be traded, so they do not count
+    // The Board finds the protected squares while generating the moves of the other color, which Mobility already did
+    Bitboard whiteProtected = board->getAllProtected(WHITE) & board->getOccupancy(WHITE) & ~board->getPieces(WHITE, KING);
+    Bitboard blackProtected = board->getAllProtected(BLACK) & board->getOccupancy(BLACK) & ~board->getPieces(BLACK, KING);
+
+    int protection = Bitboards::popCount(whiteProtected) - Bitboards::popCount(blackProtected);
+
+    return taperScore(protection * PROTECTION_SCORE[MIDDLEGAME], protection * PROTECTION_SCORE[ENDGAME]);
 }
 
 // @purpose: Calculate the Check Score for a position
@@ -545,22 +1279,145 @@ int ChessAI::calculateCheckScore()
 {
 
     // Check if the Black King is check
-    if (!board->getCheckPaths(BLACK)->empty())
+    if (board->isInCheck(BLACK))
     {
         // If Black is in check, that is good for white
-        return CHECK_SCORE;
+        return taperScore(CHECK_SCORE[MIDDLEGAME], CHECK_SCORE[ENDGAME]);
     }
 
     // Check if the White King is in check
-    if (!board->getCheckPaths(WHITE)->empty())
+    if (board->isInCheck(WHITE))
     {
         // If White is in check, that is bad for white
-        return -CHECK_SCORE;
+        return -taperScore(CHECK_SCORE[MIDDLEGAME], CHECK_SCORE[ENDGAME]);
     }
 
     return 0;
 }
 
+// @purpose: Calculate the Pawn Structure and King Shelter Score for a position
+// @parameters: None
+// @return: Pawn score for the position
+int ChessAI::calculatePawnScore()
+{
+    int score[NUM_PHASES] = { 0, 0 };
+
+    // The Pawn structure only changes when a Pawn moves or is captured, so it is usually already in the table
+    ZobristKey pawnKey = board->getPawnHash();
+    const PawnHashTable::Entry* entry = pawnTable.probe(pawnKey);
+    if (entry)
+    {
+        score[MIDDLEGAME] = entry->score[MIDDLEGAME];
+        score[ENDGAME] = entry->score[ENDGAME];
+    }
+    else
+    {
+        int white[NUM_PHASES] = { 0, 0 };
+        int black[NUM_PHASES] = { 0, 0 };
+        evaluatePawnStructure(WHITE, white);
+        evaluatePawnStructure(BLACK, black);
+
+        score[MIDDLEGAME] = white[MIDDLEGAME] - black[MIDDLEGAME];
+        score[ENDGAME] = white[ENDGAME] - black[ENDGAME];
+        pawnTable.store(pawnKey, score[MIDDLEGAME], score[ENDGAME]);
+    }
+
+    // The shelter also depends on where the Kings are, so it is not part of the Pawn key
+    int whiteShelter[NUM_PHASES] = { 0, 0 };
+    int blackShelter[NUM_PHASES] = { 0, 0 };
+    evaluateKingShelter(WHITE, whiteShelter);
+    evaluateKingShelter(BLACK, blackShelter);
+
+    score[MIDDLEGAME] += whiteShelter[MIDDLEGAME] - blackShelter[MIDDLEGAME];
+    score[ENDGAME] += whiteShelter[ENDGAME] - blackShelter[ENDGAME];
+
+    return taperScore(score[MIDDLEGAME], score[ENDGAME]);
+}
+
+// @purpose: Scores the Pawn structure of one color from its Pawn Bitboards
+// @parameters: Color of the Pawns, Middlegame and Endgame scores to add to
+// @return: None
+void ChessAI::evaluatePawnStructure(Colors color, int* score)
+{
+    Colors enemy = Chess::enemy[color];
+    Bitboard pawns = board->getPieces(color, PAWN);
+    Bitboard enemyPawns = board->getPieces(enemy, PAWN);
+
+    // White Pawns move towards index 0, Black Pawns away from it
+    int forward = (color == WHITE) ? -Chess::NumFiles : Chess::NumFiles;
+
+    Bitboard remaining = pawns;
+    while (remaining)
+    {
+        Squares sq = Bitboards::popLsb(remaining);
+        int file = sq % Chess::NumFiles;
+        int rank = (color == WHITE) ? Chess::NumRanks - 1 - sq / Chess::NumFiles : sq / Chess::NumFiles;
+
+        Bitboard neighbours = pawns & Bitboards::adjacentFiles(file);
+        Bitboard span = Bitboards::passedPawnSpan(color, sq);
+
+        // Only the Pawns behind another count as doubled, and only the front one can be passed
+        bool doubled = (pawns & Bitboards::forwardFile(color, sq)) != 0;
+        bool passed = !doubled && (enemyPawns & span) == 0;
+        bool isolated = neighbours == 0;
+
+        // Backward - every Pawn on the files next to it has already passed it,
+        // and an enemy Pawn guards the square in front of it
+        bool backward = !isolated && (neighbours & ~span) == 0 &&
+            (Bitboards::pawnAttacks(color, (Squares)(sq + forward)) & enemyPawns) != 0;
+
+        for (int phase = MIDDLEGAME; phase < NUM_PHASES; ++phase)
+        {
+            if (doubled) score[phase] += DOUBLED_PAWN_SCORE[phase];
+            if (passed) score[phase] += PASSED_PAWN_SCORE[phase][rank];
+            if (isolated) score[phase] += ISOLATED_PAWN_SCORE[phase];
+            if (backward) score[phase] += BACKWARD_PAWN_SCORE[phase];
+        }
+    }
+}
+
+// @purpose: Scores the Pawns in front of one color's King
+// @parameters: Color of the King, Middlegame and Endgame scores to add to
+// @return: None
+void ChessAI::evaluateKingShelter(Colors color, int* score)
+{
+    Bitboard pawns = board->getPieces(color, PAWN);
+    Squares king = Bitboards::lsb(board->getPieces(color, KING));
+    int kingFile = king % Chess::NumFiles;
+    int kingRank = (color == WHITE) ? Chess::NumRanks - 1 - king / Chess::NumFiles : king / Chess::NumFiles;
+
+    // A King that has left its first two ranks is not sheltering, the Piece Square Tables score it instead
+    if (kingRank > 1)
+    {
+        return;
+    }
+
+    int forward = (color == WHITE) ? -Chess::NumFiles : Chess::NumFiles;
+
+    // Look at the two squares in front of the King on its file and the files next to it
+    for (int file = std::max(kingFile - 1, 0); file <= std::min(kingFile + 1, Chess::NumFiles - 1); ++file)
+    {
+        int sq = king + file - kingFile;
+
+        for (int phase = MIDDLEGAME; phase < NUM_PHASES; ++phase)
+        {
+            if (pawns & Bitboards::squareBB(sq + forward))
+            {
+                continue;
+            }
+
+            if (pawns & Bitboards::squareBB(sq + 2 * forward))
+            {
+                score[phase] += SHELTER_ADVANCED_SCORE[phase];
+            }
+            else
+            {
+                score[phase] += SHELTER_MISSING_SCORE[phase];
+            }
+        }
+    }
+}
+
 // @purpose: Calculate the Endgame Score for a position
 // @parameters: None
 // @return: Endgame score for the position
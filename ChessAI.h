@@ -12,11 +12,18 @@
 #ifndef CHESS_AI_H
 #define CHESS_AI_H
 
+#include <atomic>
+#include <chrono>
 #include <map>
+#include <vector>
 
 #include "ChessTypes.h"
+#include "EvaluationCache.h"
 #include "EvaluationTypes.h"
 #include "Move.h"
+#include "MoveList.h"
+#include "PawnHashTable.h"
+#include "TranspositionTable.h"
 
 // Forward Declarations
 class Board;
@@ -25,29 +32,139 @@ class Piece;
 class ChessAI
 {
 public:
+    // The deepest that a timed search will iterate to
+    static const int MaxDepth = 64;
+
+    // Selective search and evaluation techniques that can be turned on or off
+    enum SearchFeatures
+    {
+        NULL_MOVE_PRUNING = 1,
+        LATE_MOVE_REDUCTIONS = 2,
+        REVERSE_FUTILITY_PRUNING = 4,
+        FUTILITY_PRUNING = 8,
+        CHECK_EXTENSIONS = 16,
+        LAZY_EVALUATION = 32,
+        ALL_SEARCH_FEATURES = 63
+    };
+
+    // Counts of how the last search went, to tune it
+    struct SearchStats
+    {
+        int aspirationResearches; // Root searches repeated after the score fell outside of the aspiration window
+        int pvsResearches;        // Null window searches repeated with the full window
+        int reductionResearches;  // Reduced searches repeated at the full depth
+        int failHighs;            // Beta cutoffs
+        int firstMoveFailHighs;   // Beta cutoffs by the first move searched
+        int evaluations;          // Positions evaluated
+        int lazyEvaluations;      // Evaluations that returned before scoring the expensive terms
+        int evalCacheHits;        // Evaluations found in the Evaluation Cache
+        int evalCacheMisses;      // Evaluations looked for in the Evaluation Cache and not found
+
+        SearchStats() : aspirationResearches(0), pvsResearches(0), reductionResearches(0), failHighs(0), firstMoveFailHighs(0),
+            evaluations(0), lazyEvaluations(0), evalCacheHits(0), evalCacheMisses(0) { ; }
+    };
+
     // Default Constructor
     ChessAI(Colors colorIn, int depthIn);
 
     // Default Destructor
     ~ChessAI();
 
-    // @purpose: Sets the depth of the AI
+    // @purpose: Sets the depth of the AI, searching to that depth instead of for a time
     // @parameters: Depth of AI
     // @return: None
     void setDepth(int strength);
 
+    // @purpose: Search for a fixed time per move instead of to a fixed depth
+    // @parameters: Time to search in milliseconds
+    // @return: None
+    void setMoveTime(int milliseconds);
+
+    // @purpose: Search for a share of the remaining clock instead of a fixed depth
+    // @parameters: Time left on the clock in milliseconds, Increment per move in milliseconds
+    // @return: None
+    void setClock(int remaining, int increment);
+
+    // @purpose: Sets the size of the Transposition Table, clearing it
+    // @parameters: Size of the table in megabytes
+    // @return: None
+    void setHashSize(int megabytes);
+
+    // @purpose: Sets the size of the Evaluation Cache of every thread, clearing them
+    // @parameters: Size of each cache in megabytes
+    // @return: None
+    void setEvalCacheSize(int megabytes);
+
+    // @purpose: Sets the number of threads that search together
+    // @parameters: Number of threads, including the main thread
+    // @return: None
+    void setThreads(int threads);
+
+    // @purpose: Turns the selective search techniques on or off, to measure the effect of each
+    // @parameters: SearchFeatures flags of the techniques to use
+    // @return: None
+    void setSearchFeatures(int features);
+
+    // @purpose: Sets how far outside of the alpha-beta window the cheap terms of the evaluation must be
+    //           for the expensive terms to be skipped, when LAZY_EVALUATION is turned on
+    // @parameters: Margin in centipawns
+    // @return: None
+    void setLazyMargin(int margin);
+
+    // @purpose: Get the number of nodes searched by the last search
+    // @parameters: None
+    // @return: Nodes of the main and quiescence searches of every thread
+    int getNodesSearched();
+
+    // @purpose: Get the statistics of the last search
+    // @parameters: None
+    // @return: Re-search and fail high counts of every thread
+    SearchStats getSearchStats();
+
     // @purpose: Get the Best move for a given color
     // @parameters: Board object
     // @return: The best move to make
     Move getBestMove(Board* boardIn, Colors color);
 
 private:
+    // Number of moves the remaining clock is planned to last
+    static const int MovesToGo = 30;
+
+    // Time in milliseconds kept back from every search to return the move
+    static const int MoveOverhead = 10;
+
+    // Mask of the node count - the clock is checked whenever these bits are all 0
+    static const int TimeCheckNodes = 2047;
 
-    // Struct to track the best variation
+    // The furthest from the root that the search can reach, the size of the PV Table
+    static const int MaxPly = 128;
+
+    // Move ordering scores of each kind of move - quiet moves are scored by their history, below the killers
+    static const int HashMoveScore = 4000000;
+    static const int CaptureScore = 3000000;
+    static const int KillerScore = 2000000;
+    static const int HistoryMax = 1000000;
+    static const int BadCaptureScore = -3000000;
+
+    // Selective search limits - the depths are the furthest from the leaves that each technique is used
+    static const int NullMoveMinDepth = 3;
+    static const int NullMoveDeepDepth = 6; // Deeper searches reduce the null move by another ply
+    static const int ReverseFutilityDepth = 3;
+    static const int ReverseFutilityMargin = 120; // Per ply of depth
+    static const int FutilityDepth = 2;
+    static const int FutilityMargin = 200; // Per ply of depth
+    static const int LateMoveMinDepth = 3;
+    static const int LateMoveIndex = 3; // Moves ordered before this are never reduced
+
+    // Half the width of the first aspiration window, doubled every time the score falls outside of it
+    static const int AspirationWindow = 50;
+    static const int AspirationMinDepth = 4;
+
+    // Struct to return the best variation of a finished iteration
     struct pvNode
     {
         int eval;
-        mvVector variation;
+        MoveList variation;
 
         pvNode() : eval(0), variation() { ; }
     };
@@ -55,8 +172,9 @@ private:
     // How far to Search
     int DEPTH;
 
-    // How many Nodes were searched
+    // How many Nodes were searched, by the main search and by the quiescence search
     int nodesSearched;
+    int quiescenceNodesSearched;
 
     // What Color the AI is playing
     Colors aiPlayer;
@@ -65,42 +183,186 @@ private:
     Board* board;
 
     // Stores the PV from last search
-    mvVector lastPV;
+    MoveList lastPV;
+
+    // Triangular PV Table - https://www.chessprogramming.org/Triangular_PV-Table
+    // Row ply holds the best line found from that ply, in pvTable[ply][ply] to pvTable[ply][pvLength[ply] - 1]
+    PackedMove pvTable[MaxPly][MaxPly];
+    int pvLength[MaxPly];
+
+    // Two quiet moves per ply that last caused a beta cutoff - https://www.chessprogramming.org/Killer_Heuristic
+    PackedMove killers[MaxPly][2];
+
+    // Butterfly history of quiet moves that caused a beta cutoff, by color and start and end square
+    // https://www.chessprogramming.org/History_Heuristic
+    int history[BLACK + 1][Chess::NumSquares][Chess::NumSquares];
+
+    // SearchFeatures flags of the selective search techniques in use
+    int searchFeatures;
+
+    // Margin of the lazy evaluation, see setLazyMargin
+    int lazyMargin;
+
+    // Depth of the current iteration, to limit how far Check Extensions can go
+    int rootDepth;
+
+    // Statistics of the current search
+    SearchStats stats;
+
+    // Remembers the results of searched positions, kept between searches
+    // Owned by the main AI and shared with all of its helpers
+    TranspositionTable* transpositionTable;
+
+    // Remembers the Pawn structure scores of evaluated positions - every thread has its own
+    PawnHashTable pawnTable;
+
+    // Remembers the static evaluations of positions - every thread has its own
+    EvaluationCache evalCache;
+
+    // Helpers that search the same position on other threads - Lazy SMP
+    // https://www.chessprogramming.org/Lazy_SMP
+    std::vector<ChessAI*> helpers;
 
-    // @purpose: Calculate the move score recursively using the MiniMax algorithm with AlphaBeta Pruning
-    // @parameters: int depth to search, Color to represent Min(Black) and Max(White)
-    // @return: Node of the best move and it's evaluation
-    ChessAI::pvNode miniMax(Move moveBefore, int depth, int alpha, int beta, Colors color);
+    // Number of the thread this AI searches on, 0 for the main AI
+    int threadId;
 
-    // @purpose: Calculate the move score recursively using the MiniMax algorithm with AlphaBeta Pruning
-    // @parameters: int depth to search, Color to represent Min(Black) and Max(White)
-    // @return: Node of the best move and it's evaluation
-    int miniMax(int depth, int alpha, int beta, Colors color);
+    // Time limits in milliseconds, all 0 when searching to a fixed depth
+    int moveTime;
+    int clockTime;
+    int clockIncrement;
 
-    // @purpose: Orders the moves for a best-first search
-    // @parameters: List of moves to order
+    // Limits of the current search in milliseconds, 0 when there is no limit
+    // No iteration is started after the soft limit, and the search is stopped at the hard limit
+    int softLimit;
+    int hardLimit;
+
+    // When the current search started
+    std::chrono::steady_clock::time_point searchStart;
+
+    // Deepest iteration that the current search has finished
+    int completedDepth;
+
+    // Set when the search runs out of time, or when the main AI stops a helper
+    std::atomic<bool> stopSearch;
+
+    // @purpose: Construct a helper of a multi-threaded search, sharing the Transposition Table of the main AI
+    // @parameters: Main AI of the search, Number of the helper thread
+    // @return: None
+    ChessAI(ChessAI* mainIn, int threadIdIn);
+
+    // @purpose: Searches the root position until stopped by the main thread, to fill the shared Transposition Table
+    // @parameters: None
+    // @return: None
+    void searchHelper();
+
+    // @purpose: Searches every move of the root position to one depth
+    // @parameters: Depth to search, alpha and beta of the aspiration window
+    // @return: Node of the best move and it's evaluation for the side to move - only a bound if outside of the window
+    ChessAI::pvNode searchRoot(int depth, int alpha, int beta);
+
+    // @purpose: Calculate the move score recursively using Negamax with AlphaBeta Pruning and Principal Variation Search
+    // @parameters: depth to search, distance from the root, alpha and beta for the side to move, if a null move may be tried
+    // @return: Evaluation of the position for the side to move - the best line is left in the PV Table at this ply
+    int negaMax(int depth, int ply, int alpha, int beta, bool allowNullMove);
+
+    // @purpose: Searches captures and promotions until the position is quiet, so that a leaf is not evaluated mid-exchange
+    // @parameters: distance from the root, alpha and beta for the side to move
+    // @return: Evaluation of the position for the side to move - the best line is left in the PV Table at this ply
+    int quiescence(int ply, int alpha, int beta);
+
+    // @purpose: Scores a win or loss only by its distance from the root, so that the quickest win and the slowest
+    //           loss are preferred - the material left when the game ends would otherwise outweigh the distance
+    // @parameters: Evaluation of a position, distance from the root
+    // @return: Evaluation adjusted for the distance
+    static int mateDistanceScore(int score, int ply);
+
+    // @purpose: Converts a score between the distance from the root and the distance from the position, since
+    //           the Transposition Table may return a win or loss at a different distance from the root than it was stored
+    // @parameters: Evaluation of a position, distance from the root - negative to convert back from the table
+    // @return: Evaluation with a win or loss counted from the other point
+    static int mateTableScore(int score, int ply);
+
+    // @purpose: Get the material that a move wins, from the piece it captures and the piece it promotes to
+    // @parameters: Move to score
+    // @return: Material gained by the move
+    int getCaptureGain(PackedMove move);
+
+    // @purpose: Scores a capture by Most Valuable Victim - Least Valuable Attacker
+    //           https://www.chessprogramming.org/MVV-LVA
+    // @parameters: Move to score
+    // @return: Higher scores for bigger captures, and for cheaper pieces making the same capture
+    int getMvvLvaScore(PackedMove move);
+
+    // @purpose: Makes a move the start of the best line from a ply, followed by the best line found after it
+    // @parameters: Distance from the root, Move that is now the best
     // @return: None
-    void moveOrdering(mvVector* moves);
+    void updatePV(int ply, PackedMove move);
 
-    // @purpose: Calculate the score for a given board
+    // @purpose: Scores the moves for a best-first search - https://www.chessprogramming.org/Move_Ordering
+    //           The hash move is first, then winning and even captures by MVV-LVA, then the killers,
+    //           then quiet moves by their history, and losing captures last
+    // @parameters: List of moves to score, Scores to fill, Best move from the Transposition Table (null if none), distance from the root
+    // @return: None
+    void scoreMoves(MoveList& moves, int* scores, PackedMove ttMove, int ply);
+
+    // @purpose: Moves the best scored of the remaining moves to the front - a lazy selection sort,
+    //           so that the moves after a cutoff are never sorted
+    // @parameters: List of moves, Scores of the moves, Index of the first remaining move
+    // @return: The best remaining move
+    PackedMove pickMove(MoveList& moves, int* scores, int index);
+
+    // @purpose: Remembers a quiet move that caused a beta cutoff, in the killers of its ply and the history table
+    // @parameters: Move that caused the cutoff, distance from the root, depth searched, Color that made the move
+    // @return: None
+    void updateKillers(PackedMove move, int ply, int depth, Colors color);
+
+    // @purpose: Removes all killer moves
     // @parameters: None
-    // @return: score for the position
-    int evaluateBoard();
+    // @return: None
+    void clearKillers();
+
+    // @purpose: Halves every entry in the history table, so that newer cutoffs count for more than older ones
+    // @parameters: None
+    // @return: None
+    void ageHistory();
+
+    // @purpose: Calculates the material that a capture wins once every exchange on its square is made
+    //           https://www.chessprogramming.org/Static_Exchange_Evaluation
+    // @parameters: Capture to evaluate
+    // @return: Material won by the side making the capture, negative if it loses material
+    int getStaticExchange(PackedMove move);
+
+    // @purpose: Decides how long the current search can take from the time limits
+    // @parameters: None
+    // @return: None
+    void calculateTimeLimits();
+
+    // @purpose: Get the time since the search started
+    // @parameters: None
+    // @return: Elapsed time in milliseconds
+    int getElapsedTime();
+
+    // @purpose: Stops the search if it has reached the hard time limit
+    // @parameters: None
+    // @return: None
+    void checkTime();
+
+    // @purpose: Calculate the score for a given board - the cheap terms are scored first, and the expensive terms
+    //           are skipped when the score is already far enough outside of the window that they can not matter
+    //           https://www.chessprogramming.org/Lazy_Evaluation
+    // @parameters: alpha and beta for the side to move, the full score is always calculated without them
+    // @return: score for the position, from the point of view of the side to move
+    int evaluateBoard(int alpha = -INFINITE_SCORE, int beta = INFINITE_SCORE);
 
     // @purpose: Calculate the Material Score for a position
     // @parameters: None
     // @return: material score for the position
     int calculateMaterialScore();
 
-    // @purpose: Get the PIece Square Table Modifier for a given piece
-    // @parameters: Pice object to evaluate
-    // @return: PSQT Modifier (addition)
-    int getPsqtModifier(Piece* piece);
-
-    // @purpose: Checks if the board is in the endgame
-    // @parameters: None
-    // @return: true if endgame, false otherwise
-    bool isEndgame();
+    // @purpose: Blends a middlegame and an endgame score by the phase of the game
+    // @parameters: Middlegame score, Endgame score
+    // @return: Score weighted towards the middlegame by the material left on the board
+    int taperScore(int middlegame, int endgame);
 
     // @purpose: Calculate the Mobility Score for a position
     // @parameters: None
@@ -117,6 +379,21 @@ private:
     // @return: Check score for the position
     int calculateCheckScore();
 
+    // @purpose: Calculate the Pawn Structure and King Shelter Score for a position
+    // @parameters: None
+    // @return: Pawn score for the position
+    int calculatePawnScore();
+
+    // @purpose: Scores the Pawn structure of one color from its Pawn Bitboards
+    // @parameters: Color of the Pawns, Middlegame and Endgame scores to add to
+    // @return: None
+    void evaluatePawnStructure(Colors color, int* score);
+
+    // @purpose: Scores the Pawns in front of one color's King
+    // @parameters: Color of the King, Middlegame and Endgame scores to add to
+    // @return: None
+    void evaluateKingShelter(Colors color, int* score);
+
     // @purpose: Calculate the Endgame Score for a position
     // @parameters: None
     // @return: Endgame score for the position
@@ -315,23 +315,24 @@ void ChessGraphics::drawHighlights(Board* board, Piece* currentPiece)
     }
 
     // Draw colors around a checked king
-    std::vector<sqVector>* checkPaths = board->getCheckPaths(board->getFen()->activeColor);
-    if (!checkPaths->empty())
+    Colors activeColor = board->getFen()->activeColor;
+    Bitboard checkers = board->getCheckers(activeColor);
+    if (checkers != 0)
     {
         sf::Color checkedKing = sf::Color(212, 41, 41);
         sf::Color checkingPiece = sf::Color(255, 150, 150);
 
-        // Iterate through all possible check paths
-        std::vector<sqVector>::iterator it = checkPaths->begin();
-
-        for (it; it != checkPaths->end(); ++it)
+        // Iterate through all pieces giving check
+        while (checkers)
         {
-            highlightSquares[it->front()].setFillColor(checkingPiece);
-            window->draw(highlightSquares[it->front()]);
-
-            highlightSquares[it->back()].setFillColor(checkedKing);
-            window->draw(highlightSquares[it->back()]);
+            Squares checker = Bitboards::popLsb(checkers);
+            highlightSquares[checker].setFillColor(checkingPiece);
+            window->draw(highlightSquares[checker]);
         }
+
+        Squares king = board->getKing(activeColor)->getPos();
+        highlightSquares[king].setFillColor(checkedKing);
+        window->draw(highlightSquares[king]);
     }
 
     // Highlight the current piece, if there is one
@@ -342,30 +343,31 @@ void ChessGraphics::drawHighlights(Board* board, Piece* currentPiece)
     window->draw(highlightSquares[currentPiece->getPos()]);
 
     const char* charBoard = board->getCharBoard();
-    mvVector* moves = currentPiece->getMoves();
+    MoveList moves;
+    board->getPieceMoves(currentPiece->getPos(), moves);
 
     // Draw all current moves
-    if (!moves->empty())
+    if (!moves.empty())
     {
         int highlightIndex = 0;
 
         sf::Color emptySquare = sf::Color(50, 180, 225);
         sf::Color takenSquare = sf::Color(255, 50, 50);
 
-        mvVector::iterator it = moves->begin();
+        MoveList::iterator it = moves.begin();
 
-        for (it = moves->begin(); it != moves->end(); ++it)
+        for (it = moves.begin(); it != moves.end(); ++it)
         {
-            if (charBoard[it->end] == '-')
+            if (charBoard[it->getEnd()] == '-')
             {
-                highlightSquares[it->end].setFillColor(emptySquare);
+                highlightSquares[it->getEnd()].setFillColor(emptySquare);
             }
             else
             {
-                highlightSquares[it->end].setFillColor(takenSquare);
+                highlightSquares[it->getEnd()].setFillColor(takenSquare);
             }
             
-            window->draw(highlightSquares[it->end]);
+            window->draw(highlightSquares[it->getEnd()]);
         }
     }
 }
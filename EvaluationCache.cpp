@@ -0,0 +1,123 @@
+//-------------------------------------------------------
+//
+// File: EvaluationCache.cpp
+// Author: Edward Koch
+// Description: Holds the definition of the EvaluationCache Class
+//
+// Revision History
+// Author    Date    Description
+//-------------------------------------------------------
+// E. Koch    10/17/26    Initial Creation of EvaluationCache class
+//-------------------------------------------------------
+#include "EvaluationCache.h"
+
+// @purpose: Construct a cache of a given size
+// @parameters: Size of the cache in megabytes
+// @return: None
+EvaluationCache::EvaluationCache(int megabytes)
+    : entries(0),
+      numEntries(0),
+      sizeMB(0),
+      hits(0),
+      misses(0)
+{
+    resize(megabytes);
+}
+
+// Default Destructor
+EvaluationCache::~EvaluationCache()
+{
+    delete[] entries;
+}
+
+// @purpose: Resizes the cache, removing all entries
+// @parameters: Size of the cache in megabytes, rounded down to a power of two number of entries
+// @return: None
+void EvaluationCache::resize(int megabytes)
+{
+    sizeMB = (megabytes < 1) ? 1 : megabytes;
+    size_t bytes = (size_t)sizeMB << 20;
+
+    // Use the largest power of two number of entries that fits in the size
+    size_t count = 1;
+    while (count * 2 * sizeof(Entry) <= bytes)
+    {
+        count *= 2;
+    }
+
+    if (count != numEntries)
+    {
+        delete[] entries;
+        entries = new Entry[count];
+        numEntries = count;
+    }
+
+    clear();
+}
+
+// @purpose: Removes all entries from the cache and resets the counts
+// @parameters: None
+// @return: None
+void EvaluationCache::clear()
+{
+    for (size_t i = 0; i < numEntries; ++i)
+    {
+        // No position has a key of all ones, so a cleared entry never matches
+        entries[i].key = ~(ZobristKey)0;
+        entries[i].score = 0;
+        entries[i].complete = false;
+    }
+    hits = 0;
+    misses = 0;
+}
+
+// @purpose: Looks up a position in the cache
+// @parameters: Zobrist key of the position
+// @return: Entry of the position, 0 if it is not in the cache
+const EvaluationCache::Entry* EvaluationCache::probe(ZobristKey key)
+{
+    Entry& entry = entries[key & (numEntries - 1)];
+    if (entry.key != key)
+    {
+        ++misses;
+        return 0;
+    }
+
+    ++hits;
+    return &entry;
+}
+
+// @purpose: Saves the evaluation of a position, replacing whatever was in its entry
+// @parameters: Zobrist key of the position, Score for White, If the evaluation has all of its terms
+// @return: None
+void EvaluationCache::store(ZobristKey key, int score, bool complete)
+{
+    Entry& entry = entries[key & (numEntries - 1)];
+    entry.key = key;
+    entry.score = score;
+    entry.complete = complete;
+}
+
+// @purpose: Get the size of the cache
+// @parameters: None
+// @return: Size of the cache in megabytes
+int EvaluationCache::getSizeMB()
+{
+    return sizeMB;
+}
+
+// @purpose: Get the number of lookups that found their position since the cache was cleared
+// @parameters: None
+// @return: Number of calls to probe that returned an entry
+uint64_t EvaluationCache::getHits()
+{
+    return hits;
+}
+
+// @purpose: Get the number of lookups that did not find their position since the cache was cleared
+// @parameters: None
+// @return: Number of calls to probe that returned 0
+uint64_t EvaluationCache::getMisses()
+{
+    return misses;
+}
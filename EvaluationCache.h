@@ -0,0 +1,101 @@
+//-------------------------------------------------------
+//
+// File: EvaluationCache.h
+// Author: Edward Koch
+// Description: Holds the declaration of the EvaluationCache Class
+//              The Evaluation Cache remembers the static evaluation of positions by their Zobrist key,
+//              so that a position reached again by a different move order is not evaluated again
+//              https://www.chessprogramming.org/Evaluation_Hash_Table
+//              It is separate from the Transposition Table, so it also remembers the quiescence positions
+//              that are never stored there. Each search thread has its own cache, so the entries need no protection
+//
+// Revision History
+// Author    Date    Description
+//-------------------------------------------------------
+// E. Koch    10/17/26    Initial Creation of EvaluationCache class
+//-------------------------------------------------------
+#ifndef EVALUATION_CACHE_H
+#define EVALUATION_CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "Zobrist.h"
+
+class EvaluationCache
+{
+public:
+    // Size of the cache when one is not given
+    static const int DefaultSizeMB = 2;
+
+    // The evaluation of one position
+    struct Entry
+    {
+        ZobristKey key;
+        int score;     // Score for White
+        bool complete; // false if the evaluation was lazy, and is missing its expensive terms
+    };
+
+    // @purpose: Construct a cache of a given size
+    // @parameters: Size of the cache in megabytes
+    // @return: None
+    EvaluationCache(int megabytes = DefaultSizeMB);
+
+    // Default Destructor
+    ~EvaluationCache();
+
+    // @purpose: Resizes the cache, removing all entries
+    // @parameters: Size of the cache in megabytes, rounded down to a power of two number of entries
+    // @return: None
+    void resize(int megabytes);
+
+    // @purpose: Removes all entries from the cache and resets the counts
+    // @parameters: None
+    // @return: None
+    void clear();
+
+    // @purpose: Looks up a position in the cache
+    // @parameters: Zobrist key of the position
+    // @return: Entry of the position, 0 if it is not in the cache
+    const Entry* probe(ZobristKey key);
+
+    // @purpose: Saves the evaluation of a position, replacing whatever was in its entry
+    // @parameters: Zobrist key of the position, Score for White, If the evaluation has all of its terms
+    // @return: None
+    void store(ZobristKey key, int score, bool complete);
+
+    // @purpose: Get the size of the cache
+    // @parameters: None
+    // @return: Size of the cache in megabytes
+    int getSizeMB();
+
+    // @purpose: Get the number of lookups that found their position since the cache was cleared
+    // @parameters: None
+    // @return: Number of calls to probe that returned an entry
+    uint64_t getHits();
+
+    // @purpose: Get the number of lookups that did not find their position since the cache was cleared
+    // @parameters: None
+    // @return: Number of calls to probe that returned 0
+    uint64_t getMisses();
+
+private:
+    // Holds all of the entries
+    Entry* entries;
+
+    // Number of entries, always a power of two so that the index is a mask of the key
+    size_t numEntries;
+
+    // Size that the cache was asked for
+    int sizeMB;
+
+    // Counts of the lookups, to measure how well the cache works
+    uint64_t hits;
+    uint64_t misses;
+
+    // The cache owns its entries, so it can not be copied
+    EvaluationCache(const EvaluationCache&);
+    EvaluationCache& operator = (const EvaluationCache&);
+};
+
+#endif // EVALUATION_CACHE_H
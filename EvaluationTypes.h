@@ -11,7 +11,21 @@
 //-------------------------------------------------------
 #pragma once
 
-// Piece Scores
+// Phases of the game that are scored differently
+// Every score is given for both phases, and blended by how much material is left - a tapered evaluation
+// https://www.chessprogramming.org/Tapered_Eval
+enum GamePhases
+{
+    MIDDLEGAME,
+    ENDGAME,
+    NUM_PHASES
+};
+
+// How much each piece counts towards the game phase - all of the starting pieces add up to TOTAL_PHASE
+const int PiecePhases[NUM_PIECES] = { 0, 1, 1, 2, 4, 0 };
+const int TOTAL_PHASE = 24;
+
+// Piece Scores - also the values the search uses to judge captures
 const int PAWN_SCORE = 100;
 const int KNIGHT_SCORE = 305; // 1 Knight is better than 3 Pawns
 const int BISHOP_SCORE = 325;
@@ -19,14 +33,44 @@ const int ROOK_SCORE = 530; // 1 Rook is better than a Minor Piece and 2 Pawns
 const int QUEEN_SCORE = 900;
 const int KING_SCORE = 20000;
 
-const int PROTECTION_SCORE = 1; // Give points for protecting more pieces
-const int MOBILITY_SCORE = 2; // Give points for being able to move
+// End Game Piece Scores - Pawns and long range pieces gain value as the board empties
+const int PAWN_EG_SCORE = 120;
+const int KNIGHT_EG_SCORE = 290; // Knights have fewer outposts without Pawns
+const int BISHOP_EG_SCORE = 340;
+const int ROOK_EG_SCORE = 570;
+const int QUEEN_EG_SCORE = 950;
+const int KING_EG_SCORE = 20000;
+
+const int PROTECTION_SCORE[NUM_PHASES] = { 1, 1 }; // Give points for protecting more pieces
+const int MOBILITY_SCORE[NUM_PHASES] = { 2, 4 }; // Give points for being able to move, more so with fewer pieces in the way
+
+const int CHECK_SCORE[NUM_PHASES] = { 50, 20 }; // Being in check is Rough, less so without pieces to follow it up
+
+// Pawn Structure Scores - https://www.chessprogramming.org/Pawn_Structure
+const int DOUBLED_PAWN_SCORE[NUM_PHASES] = { -10, -20 }; // For each Pawn behind another of its color
+const int ISOLATED_PAWN_SCORE[NUM_PHASES] = { -10, -15 }; // No Pawns of its color on the files next to it
+const int BACKWARD_PAWN_SCORE[NUM_PHASES] = { -8, -10 }; // Can not be protected by a Pawn, and can not safely advance
+
+// Passed Pawns by rank, counted from the Pawn's own side of the board
+const int PASSED_PAWN_SCORE[NUM_PHASES][Chess::NumRanks] =
+{
+    { 0,  5,  5, 10, 20, 35,  60, 0 },
+    { 0, 10, 15, 25, 45, 75, 120, 0 }
+};
 
-const int CHECK_SCORE = 50; // Being in check is Rough
+// King Shelter Scores, for each file next to a King on its first two ranks - no shelter is needed in the endgame
+const int SHELTER_ADVANCED_SCORE[NUM_PHASES] = { -10, 0 }; // The Pawn in front of the King has moved one square
+const int SHELTER_MISSING_SCORE[NUM_PHASES] = { -25, 0 }; // There is no Pawn in front of the King
 
 const int WIN_SCORE = 25000; // Incentivise Winning
 const int LOSE_SCORE = -25000; // Deincentivise Losing
 const int DRAW_SCORE = -200; // Slightly Deincentivise drawing
+const int WIN_BOUND = WIN_SCORE / 2; // Any score further from 0 than this is a forced win or loss
+
+const int INFINITE_SCORE = 1000000; // Larger than any score, and safe to negate
+
+const int DELTA_MARGIN = 200; // Quiescence skips captures that fall this far short of alpha
+const int LAZY_MARGIN = 150; // The evaluation skips mobility when the rest of the score is this far outside of the window
 
 // Index the piece scores by type of piece
 const int PieceScores[NUM_PIECES] =
@@ -38,6 +82,14 @@ const int PieceScores[NUM_PIECES] =
     QUEEN_SCORE,
     KING_SCORE
 };
+
+// Index the piece scores by game phase and type of piece
+const int PhasePieceScores[NUM_PHASES][NUM_PIECES] =
+{
+    { PAWN_SCORE, KNIGHT_SCORE, BISHOP_SCORE, ROOK_SCORE, QUEEN_SCORE, KING_SCORE },
+    { PAWN_EG_SCORE, KNIGHT_EG_SCORE, BISHOP_EG_SCORE, ROOK_EG_SCORE, QUEEN_EG_SCORE, KING_EG_SCORE }
+};
+
 // Modify the scores, positive for white, negative for black
 const int ScoreModifier[BLACK + 1] = { 1, -1 };
 
@@ -136,6 +136,12 @@ void Fen::parseFen(const char* fenString)
             {
                 halfmoveClock = (fenString[index++] - '0') + (halfmoveClock * 10);
             }
+
+            // A clock can end the string, and the loop must not step past its end
+            if (fenString[index] == '\0')
+            {
+                return;
+            }
             section++;
             break;
 
@@ -146,6 +152,12 @@ void Fen::parseFen(const char* fenString)
             {
                 fullmoveNumber = (fenString[index++] - '0') + (fullmoveNumber * 10);
             }
+
+            // A clock can end the string, and the loop must not step past its end
+            if (fenString[index] == '\0')
+            {
+                return;
+            }
             section++;
             break;
         } 
@@ -220,74 +232,12 @@ const char* Fen::constructFen(const char* pieces)
     fen[++fenIndex] = ' ';
 
     // Half Move Clock
-    if (halfmoveClock == 0)
-    {
-        fen[++fenIndex] = '0';
-    }
-    else
-    {
-        int tmpNum = halfmoveClock;
-        if (tmpNum > 1000)
-        {
-            fen[++fenIndex] = (tmpNum / 1000) + 48;
-            tmpNum = tmpNum % 1000;
-        }
-        if (tmpNum > 100)
-        {
-            fen[++fenIndex] = (tmpNum / 100) + 48;
-            tmpNum = tmpNum % 100;
-        }
-        if (tmpNum > 10)
-        {
-            fen[++fenIndex] = (tmpNum / 10) + 48;
-            tmpNum = tmpNum % 10;
-        }
-        if (tmpNum > 0)
-        {
-            fen[++fenIndex] = (tmpNum / 1) + 48;
-            tmpNum = tmpNum % 1;
-        }
-        if (tmpNum == 0 && halfmoveClock == 0)
-        {
-            fen[++fenIndex] = (tmpNum)+48;
-        }
-    }
+    appendNumber(halfmoveClock, fenIndex);
     fen[++fenIndex] = ' ';
 
     // Full Move Number
-    if (fullmoveNumber == 0)
-    {
-        fen[++fenIndex] = '0';
-    }
-    else
-    {
-        int tmpNum = fullmoveNumber;
-        if (tmpNum > 1000)
-        {
-            fen[++fenIndex] = (tmpNum / 1000) + 48;
-            tmpNum = tmpNum % 1000;
-        }
-        if (tmpNum > 100)
-        {
-            fen[++fenIndex] = (tmpNum / 100) + 48;
-            tmpNum = tmpNum % 100;
-        }
-        if (tmpNum > 10)
-        {
-            fen[++fenIndex] = (tmpNum / 10) + 48;
-            tmpNum = tmpNum % 10;
-        }
-        if (tmpNum > 0)
-        {
-            fen[++fenIndex] = (tmpNum / 1) + 48;
-            tmpNum = tmpNum % 1;
-        }
-        if (tmpNum == 0)
-        {
-            fen[++fenIndex] = (tmpNum) + 48;
-        }
-    }
-    
+    appendNumber(fullmoveNumber, fenIndex);
+
     // Fill the rest of the string with Null Characters
     while (++fenIndex < MAX_FEN_LENGTH)
     {
@@ -297,6 +247,26 @@ const char* Fen::constructFen(const char* pieces)
     return 0;
 }
 
+// @purpose: Writes a number into the FEN after the last character written
+// @parameters: Number to write, Index of the last character written - moved to the last digit
+// @return: None
+void Fen::appendNumber(int number, int& fenIndex)
+{
+    // Collect the digits from the least significant, then write them from the most
+    char digits[12];
+    int numDigits = 0;
+    do
+    {
+        digits[numDigits++] = (number % 10) + 48;
+        number /= 10;
+    } while (number > 0);
+
+    while (numDigits > 0)
+    {
+        fen[++fenIndex] = digits[--numDigits];
+    }
+}
+
 // @purpose: Parses a Fen enpassant square to a Squares type
 // @parameters: file and rank as characters
 // @return: None
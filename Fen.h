@@ -58,6 +58,11 @@ private:
     // @parameters: file and rank as characters
     // @return: None
     void parseEnPassant(char file, char rank);
+
+    // @purpose: Writes a number into the FEN after the last character written
+    // @parameters: Number to write, Index of the last character written - moved to the last digit
+    // @return: None
+    void appendNumber(int number, int& fenIndex);
 };
 
 #endif // FEN_H
@@ -18,6 +18,8 @@
 #include "Move.h"
 #include "Piece.h"
 
+const int Game::AIMoveTimes[] = { 0, 100, 250, 500, 1000, 2000, 4000 };
+
 // Default Constructor
 Game::Game()
     : board(new Board(Chess::startingFen)),
@@ -27,8 +29,8 @@ Game::Game()
       blackAI(BLACK, 5),
       whiteAIEnabled(false),
       blackAIEnabled(false),
-      whiteAIDepth(1),
-      blackAIDepth(1),
+      whiteAIStrength(1),
+      blackAIStrength(1),
       result(IN_PROGRESS),
       currentMoves(),
       currentPiece(0),
@@ -218,11 +220,10 @@ bool Game::getPvpSettings()
 bool Game::getPvcSettings()
 {
     int aiStrength = 1;
-    int aiModifier = 1;
     whiteAIEnabled = false;
     blackAIEnabled = true;
 
-    blackAIDepth = aiStrength + aiModifier;
+    blackAIStrength = aiStrength;
 
     sf::RenderWindow* window = drawer->getWindow();
     while (window->isOpen())
@@ -283,16 +284,16 @@ bool Game::getPvcSettings()
                         whiteAIEnabled = false;
                         blackAIEnabled = true;
 
-                        blackAIDepth = aiStrength;
-                        blackAI.setDepth(blackAIDepth + aiModifier);
+                        blackAIStrength = aiStrength;
+                        setAIStrength(blackAI, blackAIStrength);
                     }
                     else
                     {
                         whiteAIEnabled = true;
                         blackAIEnabled = false;
 
-                        whiteAIDepth = aiStrength;
-                        whiteAI.setDepth(whiteAIDepth + aiModifier);
+                        whiteAIStrength = aiStrength;
+                        setAIStrength(whiteAI, whiteAIStrength);
                     }
 
                     return true;
@@ -309,14 +310,13 @@ bool Game::getPvcSettings()
 // @return: True if start is pressed, false if right click
 bool Game::getCvcSettings()
 {
-    int aiModifier = 1;
     whiteAIEnabled = true;
     blackAIEnabled = true;
 
     sf::RenderWindow* window = drawer->getWindow();
     while (window->isOpen())
     {
-        drawer->drawCvcMenu(whiteAIDepth, blackAIDepth);
+        drawer->drawCvcMenu(whiteAIStrength, blackAIStrength);
 
         sf::Event event;
         while (window->pollEvent(event))
@@ -343,7 +343,7 @@ bool Game::getCvcSettings()
                     int file = sq % Chess::NumFiles;
                     if (file >= 1 && file <= 6)
                     {
-                        whiteAIDepth = file;
+                        whiteAIStrength = file;
                     }
                 }
                 // Get the Black AI Strength
@@ -352,7 +352,7 @@ bool Game::getCvcSettings()
                     int file = sq % Chess::NumFiles;
                     if (file >= 1 && file <= 6)
                     {
-                        blackAIDepth = file;
+                        blackAIStrength = file;
                     }
 
                 }
@@ -361,8 +361,8 @@ bool Game::getCvcSettings()
                     (sq % Chess::NumFiles == 3 ||
                         sq % Chess::NumFiles == 4))
                 {
-                    whiteAI.setDepth(whiteAIDepth + aiModifier);
-                    blackAI.setDepth(blackAIDepth + aiModifier);
+                    setAIStrength(whiteAI, whiteAIStrength);
+                    setAIStrength(blackAI, blackAIStrength);
                     return true;
                 }
 
@@ -373,6 +373,14 @@ bool Game::getCvcSettings()
     return false;
 }
 
+// @purpose: Sets an AI to search each move for the time of a strength
+// @parameters: AI to set, Strength from the settings menu
+// @return: None
+void Game::setAIStrength(ChessAI& ai, int strength)
+{
+    ai.setMoveTime(AIMoveTimes[strength]);
+}
+
 // @purpose: Processes a Mousclick Input
 // @parameters: Event to process
 // @return: None
@@ -403,7 +411,7 @@ void Game::processLeftClick(sf::Event event)
     if (currentPiece != 0)
     {
         // Check if the mouse click is in the set of moves
-        if (currentPiece->isSquareInMoves(sq))
+        if (isSquareInMoves(sq))
         {
             // Make the move
             makeMove(currentPiece, sq);
@@ -416,7 +424,7 @@ void Game::processLeftClick(sf::Event event)
                 Logger::log("%s\n", board->getFenString());
             }
             currentPiece = 0;
-            currentMoves = 0;
+            currentMoves.clear();
         }
         else
         {
@@ -447,9 +455,25 @@ void Game::selectPieceAt(Squares sq)
         }
         else
         {
-            currentMoves = currentPiece->getMoves();
+            board->getPieceMoves(sq, currentMoves);
+        }
+    }
+}
+
+// @purpose: Checks if an end square is in the current piece's set of moves
+// @parameters: Square to move to
+// @return: True if it is a valid ending square, false otherwise
+bool Game::isSquareInMoves(Squares sq)
+{
+    for (MoveList::iterator it = currentMoves.begin(); it != currentMoves.end(); ++it)
+    {
+        if (it->getEnd() == sq)
+        {
+            return true;
         }
     }
+
+    return false;
 }
 
 // @purpose: Processes a Right Click Input
@@ -469,7 +493,7 @@ void Game::processRightClick(sf::Event event)
     if (currentPiece != 0)
     {
         currentPiece = 0;
-        currentMoves = 0;
+        currentMoves.clear();
     }
 }
 
@@ -491,18 +515,38 @@ void Game::makeMove(Piece* piece, Squares square)
         pawnPromotion = tolower(drawer->getPawnPromotionOption(board->fen.activeColor));
     }  
 
+    // Find the piece that was chosen for a Pawn promotion
+    PieceTypes promotionType = NUM_PIECES;
+    switch (tolower(pawnPromotion))
+    {
+    case 'q':
+        promotionType = QUEEN;
+        break;
+
+    case 'r':
+        promotionType = ROOK;
+        break;
+
+    case 'b':
+        promotionType = BISHOP;
+        break;
+
+    case 'n':
+        promotionType = KNIGHT;
+        break;
+    }
+
     // Find the Move in the Move vector
-    Move move;
-    move.pieceMoved = piece;
-    move.start = piece->getPos();
-    move.end = square;
-    move.targetPromotion = pawnPromotion;
-
-    mvVector* moves = board->getAllMoves(piece->getColor());
-    mvVector::iterator it = std::find(moves->begin(), moves->end(), move);
-    if (it != moves->end())
+    MoveList* moves = board->getAllMoves(piece->getColor());
+    for (MoveList::iterator it = moves->begin(); it != moves->end(); ++it)
     {
-        board->makeMove(*it);
-        board->getMoveHistory()->back().printMove(true);
+        if (it->getStart() == piece->getPos() &&
+            it->getEnd() == square &&
+            (!it->isPromotion() || it->getPromotion() == promotionType))
+        {
+            board->makeMove(board->createMove(*it));
+            board->getMoveHistory()->back().printMove(true);
+            break;
+        }
     }
 }
\ No newline at end of file
@@ -55,14 +55,18 @@ private:
 
     // AI Settings
     bool whiteAIEnabled;
-    int whiteAIDepth;
+    int whiteAIStrength;
 
     bool blackAIEnabled;
-    int blackAIDepth;
+    int blackAIStrength;
+
+    // Milliseconds an AI searches each move for, by strength
+    // A time plays at the same pace in every position, where a depth is instant in some and minutes in others
+    static const int AIMoveTimes[];
 
     // Nescessary 'global' variables for passing between functions
     GameResults result;
-    mvVector* currentMoves;
+    MoveList currentMoves;
     Piece* currentPiece;
 
     // Holds a Graphics Driver to display all of the chess game
@@ -88,6 +92,11 @@ private:
     // @return: True if start is pressed, false if right click
     bool getCvcSettings();
 
+    // @purpose: Sets an AI to search each move for the time of a strength
+    // @parameters: AI to set, Strength from the settings menu
+    // @return: None
+    void setAIStrength(ChessAI& ai, int strength);
+
     // @purpose: Processes a Mousclick Input
     // @parameters: Event to process
     // @return: None
@@ -103,6 +112,11 @@ private:
     // @return: None
     void selectPieceAt(Squares sq);
 
+    // @purpose: Checks if an end square is in the current piece's set of moves
+    // @parameters: Square to move to
+    // @return: True if it is a valid ending square, false otherwise
+    bool isSquareInMoves(Squares sq);
+
     // @purpose: Processes a Right Click Input
     // @parameters: Event to process
     // @return: None
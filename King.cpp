@@ -26,49 +26,22 @@ King::~King()
 
 }
 
-// @purpose: Calculate all possible moves given a character representation of the boad
-// @parameters: Character Representation of the board, Color of piece that is moving
+// @purpose: Calculate all possible moves of this piece
+// @parameters: Board object to search, Move list to add the moves to
 // @return: None
-void King::calculateMoves(Board* board, Colors turn)
+void King::calculateMoves(Board* board, MoveList& moveList)
 {
-    // Clear all possible moves
-    moves.clear();
-    protecting.clear();
-
     // Get Character Representation of the board
     const char* charBoard = board->getCharBoard();
 
-    // Holds all possible differences between current position and desired square
-    int moveValues[8] = { -9, -8, -7, -1, 1, 7, 8, 9 };
-
     // All of the squares that the enemy pieces are protecting
-    sqVector* enemyProtecting;
-    if (turn == WHITE)
-    {
-        enemyProtecting = board->getAllProtected(BLACK);
-    }
-    else
-    {
-        enemyProtecting = board->getAllProtected(WHITE);
-    }
+    Bitboard enemyProtecting = board->getAllProtected(Chess::enemy[color]);
 
-    // Calculate all of the Kings moves
-    for (int i = 0; i < 8; i++)
+    // Calculate all of the Kings moves from the precomputed attack table
+    Bitboard targets = Bitboards::kingAttacks(position);
+    while (targets)
     {
-        int potentialMove = position + moveValues[i];
-
-        // Do not check moves that are out of range
-        if (potentialMove < A8 || potentialMove > H1)
-        {
-            continue;
-        }
-
-        // Avoid wrapping around the board
-        if (abs(position % Chess::NumFiles - potentialMove % Chess::NumFiles) > 1)
-        {
-            // If the files are furthur than 2 apart, there was wrapping
-            continue;
-        }
+        Squares potentialMove = Bitboards::popLsb(targets);
 
         // If the square is empty or is an enemy piece
         if (charBoard[potentialMove] == '-' ||
@@ -76,27 +49,17 @@ void King::calculateMoves(Board* board, Colors turn)
                 isupper(charBoard[potentialMove]) != isupper(charId)))
         {
             // Check if the move would put the King in Check
-            sqVector::iterator it = std::find(enemyProtecting->begin(), enemyProtecting->end(), potentialMove);
-
-            if (it == enemyProtecting->end())
+            if ((enemyProtecting & Bitboards::squareBB(potentialMove)) == 0)
             {
                 // Add the potential move to the move vector
-                addMove(potentialMove);
+                addMove(moveList, potentialMove, (charBoard[potentialMove] == '-') ? PackedMove::QUIET : PackedMove::CAPTURE);
             }
-            // The King is still 'protecting' this square - which disallows the enemy king to move there
-            protecting.push_back((Squares)potentialMove);
-        }
-        // If the square has a friendly piece
-        else if (charBoard[potentialMove] != '-' &&
-            isupper(charBoard[potentialMove]) == isupper(charId))
-        {
-            protecting.push_back((Squares)potentialMove);
         }
     }
 
     // Handle Castleing
     // Can not castle if in check
-    if (!board->getCheckPaths(color)->empty())
+    if (board->getCheckers(color) != 0)
     {
         return;
     }
@@ -107,20 +70,10 @@ void King::calculateMoves(Board* board, Colors turn)
             charBoard[A1] == 'R' && board->getFen()->queenCastleWhite)
         {
             // Check if the move would put the King in Check
-            sqVector::iterator it = std::find(enemyProtecting->begin(), enemyProtecting->end(), D1);
-            sqVector::iterator jt = std::find(enemyProtecting->begin(), enemyProtecting->end(), C1);
-
-            if (it == enemyProtecting->end() &&
-                jt == enemyProtecting->end())
+            if ((enemyProtecting & (Bitboards::squareBB(D1) | Bitboards::squareBB(C1))) == 0)
             {
                 // Add the potential move to the move vector
-                Move move;
-                move.pieceMoved = this;
-                move.start = position;
-                move.end = C1;
-                move.pieceCastled = board->getPieceAt(A1);
-                move.castledFrom = A1;
-                moves.push_back(move);
+                addMove(moveList, C1, PackedMove::QUEEN_CASTLE);
             }
         }
         // Check Kingside Castling
@@ -128,20 +81,10 @@ void King::calculateMoves(Board* board, Colors turn)
             charBoard[H1] == 'R' && board->getFen()->kingCastleWhite)
         {
             // Check if the move would put the King in Check
-            sqVector::iterator it = std::find(enemyProtecting->begin(), enemyProtecting->end(), F1);
-            sqVector::iterator jt = std::find(enemyProtecting->begin(), enemyProtecting->end(), G1);
-
-            if (it == enemyProtecting->end() &&
-                jt == enemyProtecting->end())
+            if ((enemyProtecting & (Bitboards::squareBB(F1) | Bitboards::squareBB(G1))) == 0)
             {
                 // Add the potential move to the move vector
-                Move move;
-                move.pieceMoved = this;
-                move.start = position;
-                move.end = G1;
-                move.pieceCastled = board->getPieceAt(H1);
-                move.castledFrom = H1;
-                moves.push_back(move);
+                addMove(moveList, G1, PackedMove::KING_CASTLE);
             }
         }
     }
@@ -152,20 +95,10 @@ void King::calculateMoves(Board* board, Colors turn)
             charBoard[A8] == 'r' && board->getFen()->queenCastleBlack)
         {
             // Check if the move would put the King in Check
-            sqVector::iterator it = std::find(enemyProtecting->begin(), enemyProtecting->end(), D8);
-            sqVector::iterator jt = std::find(enemyProtecting->begin(), enemyProtecting->end(), C8);
-
-            if (it == enemyProtecting->end() &&
-                jt == enemyProtecting->end())
+            if ((enemyProtecting & (Bitboards::squareBB(D8) | Bitboards::squareBB(C8))) == 0)
             {
                 // Add the potential move to the move vector
-                Move move;
-                move.pieceMoved = this;
-                move.start = position;
-                move.end = C8;
-                move.pieceCastled = board->getPieceAt(A8);
-                move.castledFrom = A8;
-                moves.push_back(move);
+                addMove(moveList, C8, PackedMove::QUEEN_CASTLE);
             }
         }
         // Check Kingside Castling
@@ -173,20 +106,10 @@ void King::calculateMoves(Board* board, Colors turn)
             charBoard[H8] == 'r' && board->getFen()->kingCastleBlack)
         {
             // Check if the move would put the King in Check
-            sqVector::iterator it = std::find(enemyProtecting->begin(), enemyProtecting->end(), F8);
-            sqVector::iterator jt = std::find(enemyProtecting->begin(), enemyProtecting->end(), G8);
-
-            if (it == enemyProtecting->end() &&
-                jt == enemyProtecting->end())
+            if ((enemyProtecting & (Bitboards::squareBB(F8) | Bitboards::squareBB(G8))) == 0)
             {
                 // Add the potential move to the move vector
-                Move move;
-                move.pieceMoved = this;
-                move.start = position;
-                move.end = G8;
-                move.pieceCastled = board->getPieceAt(H8);
-                move.castledFrom = H8;
-                moves.push_back(move);
+                addMove(moveList, G8, PackedMove::KING_CASTLE);
             }
         }
     }
@@ -25,17 +25,10 @@ public:
     // Default Destructor
     ~Knight();
 
-    // @purpose: Calculate all possible moves given a character representation of the boad
-    // @parameters: Character Representation of the board, Color of piece that is moving
+    // @purpose: Calculate all possible moves of this piece
+    // @parameters: Board object to search, Move list to add the moves to
     // @return: None
-    virtual void calculateMoves(Board* board, Colors turn);
-
-private:
-
-    // @purpose: Check if any other of the same piece could move to the same square
-    // @parameters: Char board to search, Move to update
-    // @return: None
-    void addDisambiguations(const char* charBoard, Move& move);
+    virtual void calculateMoves(Board* board, MoveList& moveList);
 
 };
 
@@ -28,7 +28,8 @@ Move::Move()
       castledFrom(INVALID),
       piecePromoted(0),
       targetPromotion('\0'),
-      oldFen()
+      moveNumber(0),
+      code()
 {
 
 }
@@ -47,7 +48,7 @@ void Move::printMove(bool newline)
     // Print the move number if white
     if (pieceMoved->getColor() == WHITE)
     {
-        Logger::log("%i. ", oldFen.fullmoveNumber);
+        Logger::log("%i. ", moveNumber);
     }
     // Handle Castles specially
     if (pieceCastled != 0)
@@ -118,9 +119,9 @@ void Move::printMove(bool newline)
     }
 
     // If there was a pawn promotion, specify the piece chose
-    if (piecePromoted != 0)
+    if (targetPromotion != '\0')
     {
-        Logger::log("=%c", toupper(piecePromoted->getCharId()));
+        Logger::log("=%c", toupper(targetPromotion));
     }
 
     // Print a newline or space
@@ -14,10 +14,13 @@
 
 #include "ChessTypes.h"
 #include "Fen.h"
+#include "PackedMove.h"
 
 // Forward Declaration
 class Piece;
 
+// Holds all of the information needed to display a move
+// Move generation and search use the smaller PackedMove
 class Move
 {
 public:
@@ -42,8 +45,11 @@ public:
     Piece* piecePromoted;
     char targetPromotion;
 
-    // Board Information
-    Fen oldFen;
+    // Board Information - the full move number that this move was played on
+    int moveNumber;
+
+    // Compact version of this move that is made on the board
+    PackedMove code;
 
     // @purpose: Prints the move in algebraic notation
     // @parameters: None
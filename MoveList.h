@@ -0,0 +1,125 @@
+//-------------------------------------------------------
+//
+// File: MoveList.h
+// Author: Edward Koch
+// Description: Holds the declaration of the MoveList Class
+//              A MoveList is a fixed size list of PackedMoves that can live on the stack,
+//              so that generating and searching moves never allocates memory
+//
+// Revision History
+// Author    Date    Description
+//-------------------------------------------------------
+// E. Koch    10/17/26    Initial Creation of MoveList class
+//-------------------------------------------------------
+#ifndef MOVE_LIST_H
+#define MOVE_LIST_H
+
+#include "PackedMove.h"
+
+class MoveList
+{
+public:
+    // No legal chess position has more than 218 moves
+    static const int MaxMoves = 256;
+
+    typedef PackedMove* iterator;
+    typedef const PackedMove* const_iterator;
+
+    // Default Constructor
+    MoveList()
+        : count(0)
+    {
+    }
+
+    // Copy Constructor - only copies the moves in use
+    MoveList(const MoveList& other)
+        : count(other.count)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            moves[i] = other.moves[i];
+        }
+    }
+
+    // Assignment Operator - only copies the moves in use
+    MoveList& operator = (const MoveList& other)
+    {
+        count = other.count;
+        for (int i = 0; i < count; ++i)
+        {
+            moves[i] = other.moves[i];
+        }
+        return *this;
+    }
+
+    // @purpose: Adds a move to the end of the list
+    // @parameters: Move to add
+    // @return: None
+    inline void add(PackedMove move)
+    {
+        moves[count++] = move;
+    }
+
+    // @purpose: Removes all moves from the list
+    // @parameters: None
+    // @return: None
+    inline void clear()
+    {
+        count = 0;
+    }
+
+    // @purpose: Get the number of moves in the list
+    // @parameters: None
+    // @return: Number of moves
+    inline int size() const
+    {
+        return count;
+    }
+
+    // @purpose: Checks if the list has no moves
+    // @parameters: None
+    // @return: true if there are no moves, false otherwise
+    inline bool empty() const
+    {
+        return count == 0;
+    }
+
+    // Accessors for a move in the list
+    inline PackedMove& operator [] (int index)
+    {
+        return moves[index];
+    }
+
+    inline const PackedMove& operator [] (int index) const
+    {
+        return moves[index];
+    }
+
+    // Iterators over the moves in use
+    inline iterator begin()
+    {
+        return moves;
+    }
+
+    inline iterator end()
+    {
+        return moves + count;
+    }
+
+    inline const_iterator begin() const
+    {
+        return moves;
+    }
+
+    inline const_iterator end() const
+    {
+        return moves + count;
+    }
+
+private:
+    // Holds the moves, only the first count are in use
+    PackedMove moves[MaxMoves];
+    int count;
+};
+
+#endif // MOVE_LIST_H
@@ -0,0 +1,37 @@
+//-------------------------------------------------------
+//
+// File: PackedMove.cpp
+// Author: Edward Koch
+// Description: Holds the definition of the PackedMove Class
+//
+// Revision History
+// Author    Date    Description
+//-------------------------------------------------------
+// E. Koch    10/17/26    Initial Creation of PackedMove class
+//-------------------------------------------------------
+#include <cctype>
+
+#include "Logger.h"
+#include "PackedMove.h"
+
+// @purpose: Prints the move in coordinate notation (e2e4, e7e8q)
+// @parameters: None
+// @return: None
+void PackedMove::printMove() const
+{
+    // Characters of the pieces that a Pawn can promote to, starting at KNIGHT
+    const char promotionChars[4] = { 'n', 'b', 'r', 'q' };
+
+    Squares start = getStart();
+    Squares end = getEnd();
+
+    Logger::log("%c%c%c%c", tolower(Chess::File[start % Chess::NumFiles]),
+                            Chess::Rank[start / Chess::NumRanks],
+                            tolower(Chess::File[end % Chess::NumFiles]),
+                            Chess::Rank[end / Chess::NumRanks]);
+
+    if (isPromotion())
+    {
+        Logger::log("%c", promotionChars[getPromotion() - KNIGHT]);
+    }
+}
@@ -0,0 +1,170 @@
+//-------------------------------------------------------
+//
+// File: PackedMove.h
+// Author: Edward Koch
+// Description: Holds the declaration of the PackedMove Class
+//              A PackedMove stores a move in 16 bits for move generation and search
+//              bits 0-5 are the start square, bits 6-11 are the end square,
+//              and bits 12-15 are the flags below
+//              The full Move class is only built from a PackedMove for display
+//
+// Revision History
+// Author    Date    Description
+//-------------------------------------------------------
+// E. Koch    10/17/26    Initial Creation of PackedMove class
+//-------------------------------------------------------
+#ifndef PACKED_MOVE_H
+#define PACKED_MOVE_H
+
+#include <stdint.h>
+
+#include "ChessTypes.h"
+
+class PackedMove
+{
+public:
+    // Special move information stored in the flag bits
+    // Promotions add the promoted piece (KNIGHT to QUEEN) to PROMOTION, and may also be a CAPTURE
+    enum Flags
+    {
+        QUIET = 0,
+        DOUBLE_PUSH = 1,
+        KING_CASTLE = 2,
+        QUEEN_CASTLE = 3,
+        CAPTURE = 4,
+        EN_PASSANT = 5,
+        PROMOTION = 8
+    };
+
+    // Default Constructor - an empty move
+    PackedMove()
+        : data(0)
+    {
+    }
+
+    // @purpose: Construct a move from its squares and flags
+    // @parameters: Square to move from, Square to move to, Flags of the move
+    // @return: None
+    PackedMove(Squares start, Squares end, int flags = QUIET)
+        : data((uint16_t)(start | (end << 6) | (flags << 12)))
+    {
+    }
+
+    // @purpose: Construct a move from the 16 bits returned by getData
+    // @parameters: Packed move data
+    // @return: None
+    explicit PackedMove(uint16_t dataIn)
+        : data(dataIn)
+    {
+    }
+
+    // @purpose: Get the 16 bits that hold the move, to store it elsewhere
+    // @parameters: None
+    // @return: Packed move data
+    inline uint16_t getData() const
+    {
+        return data;
+    }
+
+    // @purpose: Get the square the move starts from
+    // @parameters: None
+    // @return: Start square
+    inline Squares getStart() const
+    {
+        return (Squares)(data & 0x3F);
+    }
+
+    // @purpose: Get the square the move ends on
+    // @parameters: None
+    // @return: End square
+    inline Squares getEnd() const
+    {
+        return (Squares)((data >> 6) & 0x3F);
+    }
+
+    // @purpose: Get the flags of the move
+    // @parameters: None
+    // @return: Flags of the move
+    inline int getFlags() const
+    {
+        return data >> 12;
+    }
+
+    // @purpose: Checks if the move captures a piece, including En Passant
+    // @parameters: None
+    // @return: true if the move is a capture, false otherwise
+    inline bool isCapture() const
+    {
+        return (getFlags() & CAPTURE) != 0;
+    }
+
+    // @purpose: Checks if the move promotes a Pawn
+    // @parameters: None
+    // @return: true if the move is a promotion, false otherwise
+    inline bool isPromotion() const
+    {
+        return (getFlags() & PROMOTION) != 0;
+    }
+
+    // @purpose: Get the piece that a Pawn promotes to
+    // @parameters: None
+    // @return: Type of the promoted piece
+    inline PieceTypes getPromotion() const
+    {
+        return (PieceTypes)(KNIGHT + (getFlags() & 3));
+    }
+
+    // @purpose: Checks if the move is a castle
+    // @parameters: None
+    // @return: true if the move castles either side, false otherwise
+    inline bool isCastle() const
+    {
+        return getFlags() == KING_CASTLE || getFlags() == QUEEN_CASTLE;
+    }
+
+    // @purpose: Checks if the move is an En Passant capture
+    // @parameters: None
+    // @return: true if the move is En Passant, false otherwise
+    inline bool isEnPassant() const
+    {
+        return getFlags() == EN_PASSANT;
+    }
+
+    // @purpose: Checks if the move is a Pawn moving two squares
+    // @parameters: None
+    // @return: true if the move is a double Pawn push, false otherwise
+    inline bool isDoublePush() const
+    {
+        return getFlags() == DOUBLE_PUSH;
+    }
+
+    // @purpose: Checks if this is an empty move
+    // @parameters: None
+    // @return: true if there is no move, false otherwise
+    inline bool isNull() const
+    {
+        return data == 0;
+    }
+
+    // Comparator functions
+    inline bool operator == (const PackedMove& m) const
+    {
+        return data == m.data;
+    }
+
+    inline bool operator != (const PackedMove& m) const
+    {
+        return data != m.data;
+    }
+
+    // @purpose: Prints the move in coordinate notation (e2e4, e7e8q)
+    // @parameters: None
+    // @return: None
+    void printMove() const;
+
+private:
+    // Holds the start square, end square and flags
+    uint16_t data;
+};
+
+#endif // PACKED_MOVE_H
@@ -26,23 +26,14 @@ Pawn::~Pawn()
 
 }
 
-// @purpose: Calculate all possible moves given a character representation of the boad
-// @parameters: Character Representation of the board, Color of piece that is moving
+// @purpose: Calculate all possible moves of this piece
+// @parameters: Board object to search, Move list to add the moves to
 // @return: None
-void Pawn::calculateMoves(Board* board, Colors turn)
+void Pawn::calculateMoves(Board* board, MoveList& moveList)
 {
-    // Clear all possible moves
-    moves.clear();
-    protecting.clear();
-
     // Get Character Representation of the board
     const char* charBoard = board->getCharBoard();
 
-    // Path of the attacking piece to the King - 
-    // For a Pawn, only the current position is in the path, as Pawn captures cant be blocked
-    sqVector pathToKing;
-    pathToKing.push_back(position);
-
     // Use a modifier to commonize code between colors
     int modifier = 0;
     bool isStartingRank = false;
@@ -79,14 +70,14 @@ void Pawn::calculateMoves(Board* board, Colors turn)
             isLegalMove(board, (Squares)forwardOne))
         {
             // Add the potential move to the move vector
-            addPawnMoves(forwardOne);
+            addPawnMoves(moveList, forwardOne);
         }
 
         // On first move, a Pawn may move 2 squares foward  if unimpeaded - and is otherwise legal
         if (isStartingRank && charBoard[forwardOne] == '-' && charBoard[forwardTwo] == '-' && isLegalMove(board, (Squares)forwardTwo))
         {
             // Add the potential move to the move vector
-            addPawnMoves(forwardTwo);
+            addMove(moveList, forwardTwo, PackedMove::DOUBLE_PUSH);
         }
     }
 
@@ -99,14 +90,7 @@ void Pawn::calculateMoves(Board* board, Colors turn)
         if (charBoard[captureRight] != '-' && isupper(charBoard[captureRight]) != isupper(charId))
         {
             // Add the potential move to the move vector
-            addPawnMoves(captureRight);
-
-            // If the piece is a King, put it in check
-            if (board->getPieceAt((Squares)captureRight)->getType() == KING)
-            {
-                pathToKing.push_back((Squares)captureRight);
-                board->addCheckPath(pathToKing, Chess::enemy[color]);
-            }
+            addPawnMoves(moveList, captureRight, PackedMove::CAPTURE);
         }
         // Pawns may capture en Passant
         else if (captureRight == board->getFen()->enPassantTarget)
@@ -118,16 +102,9 @@ void Pawn::calculateMoves(Board* board, Colors turn)
             if (safeEnPassant(captureRight, board))
             {
                 // Add the potential move to the move vector
-                addPawnMoves(captureRight);
-                moves.back().isEnPassant = true;
-                protecting.push_back((Squares)captureRight);
+                addMove(moveList, captureRight, PackedMove::EN_PASSANT);
             }
         }
-        // If the square will be protected by the pawn
-        else
-        {
-            protecting.push_back((Squares)captureRight);
-        } 
     }
     // Ignore positions that are off of the board or wrapped around - or is otherwise illegal
     if (captureLeft >= A8 && captureLeft <= H1 &&
@@ -138,14 +115,7 @@ void Pawn::calculateMoves(Board* board, Colors turn)
         if (charBoard[captureLeft] != '-' && isupper(charBoard[captureLeft]) != isupper(charId))
         {
             // Add the potential move to the move vector
-            addPawnMoves(captureLeft);
-
-            // If the piece is a King, put it in check
-            if (board->getPieceAt((Squares)captureLeft)->getType() == KING)
-            {
-                pathToKing.push_back((Squares)captureLeft);
-                board->addCheckPath(pathToKing, Chess::enemy[color]);
-            }
+            addPawnMoves(moveList, captureLeft, PackedMove::CAPTURE);
         }
         // Pawns may capture en Passant
         else if (captureLeft == board->getFen()->enPassantTarget)
@@ -156,16 +126,9 @@ void Pawn::calculateMoves(Board* board, Colors turn)
             if (safeEnPassant(captureLeft, board))
             {
                 // Add the potential move to the move vector
-                addPawnMoves(captureLeft);
-                moves.back().isEnPassant = true;
-                protecting.push_back((Squares)captureLeft);
+                addMove(moveList, captureLeft, PackedMove::EN_PASSANT);
             }
         }
-        // If the square will be protected by the pawn
-        else
-        {
-            protecting.push_back((Squares)captureLeft);
-        }
     }
 }
 
@@ -299,9 +262,9 @@ bool Pawn::safeEnPassant(int end, Board* board)
 
 
 // @purpose: Add All possible moves to the move list - including opssible promotion
-// @parameters: Square to move to
+// @parameters: Move list to add to, Square to move to, PackedMove flags of the move
 // @return: None
-void Pawn::addPawnMoves(int end)
+void Pawn::addPawnMoves(MoveList& moveList, int end, int flags)
 {
     // Handle Pawn promotion
     if ((color == WHITE &&
@@ -311,30 +274,17 @@ void Pawn::addPawnMoves(int end)
     {
         // Add All Possible Promotions
         const int numOptions = 4;
-        char promotionTargets[numOptions] = { 'Q', 'R', 'B', 'N' };
+        PieceTypes promotionTargets[numOptions] = { QUEEN, ROOK, BISHOP, KNIGHT };
 
         for (int i = 0; i < numOptions; ++i)
         {
-            char option = promotionTargets[i];
-            if (color == BLACK)
-            {
-                option = tolower(option);
-            }
-
-            Move move;
-            move.pieceMoved = this;
-            move.start = position;
-            move.end = (Squares)end;
-            move.targetPromotion = option;
-
-            moves.push_back(move);
+            addMove(moveList, end, flags | PackedMove::PROMOTION | (promotionTargets[i] - KNIGHT));
         }
     }
     else
     {
         // Add move as normal
-        addMove(end);
+        addMove(moveList, end, flags);
     }
 
 }
-
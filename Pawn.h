@@ -24,10 +24,10 @@ public:
     // Default Destructor
     ~Pawn();
 
-    // @purpose: Calculate all possible moves given a character representation of the boad
-    // @parameters: Character Representation of the board, Color of piece that is moving
+    // @purpose: Calculate all possible moves of this piece
+    // @parameters: Board object to search, Move list to add the moves to
     // @return: None
-    virtual void calculateMoves(Board* board, Colors turn);
+    virtual void calculateMoves(Board* board, MoveList& moveList);
 
 private:
     // @purpose: Check if En Passant will cause a check
@@ -36,9 +36,9 @@ private:
     bool safeEnPassant(int end, Board* board);
 
     // @purpose: Add All possible moves to the move list - including opssible promotion
-    // @parameters: Square to move to
+    // @parameters: Move list to add to, Square to move to, PackedMove flags of the move
     // @return: None
-    void addPawnMoves(int end);
+    void addPawnMoves(MoveList& moveList, int end, int flags = PackedMove::QUIET);
 
 };
 
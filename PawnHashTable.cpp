@@ -0,0 +1,99 @@
+//-------------------------------------------------------
+//
+// File: PawnHashTable.cpp
+// Author: Edward Koch
+// Description: Holds the definition of the PawnHashTable Class
+//
+// Revision History
+// Author    Date    Description
+//-------------------------------------------------------
+// E. Koch    10/17/26    Initial Creation of PawnHashTable class
+//-------------------------------------------------------
+#include "PawnHashTable.h"
+
+// @purpose: Construct a table of a given size
+// @parameters: Size of the table in megabytes
+// @return: None
+PawnHashTable::PawnHashTable(int megabytes)
+    : entries(0),
+      numEntries(1),
+      probes(0),
+      hits(0)
+{
+    size_t bytes = (size_t)((megabytes < 1) ? 1 : megabytes) << 20;
+
+    // Use the largest power of two number of entries that fits in the size
+    while (numEntries * 2 * sizeof(Entry) <= bytes)
+    {
+        numEntries *= 2;
+    }
+
+    entries = new Entry[numEntries];
+    clear();
+}
+
+// Default Destructor
+PawnHashTable::~PawnHashTable()
+{
+    delete[] entries;
+}
+
+// @purpose: Removes all entries from the table and resets the counts
+// @parameters: None
+// @return: None
+void PawnHashTable::clear()
+{
+    for (size_t i = 0; i < numEntries; ++i)
+    {
+        // No position has a key of all ones, so a cleared entry never matches
+        entries[i].key = ~(ZobristKey)0;
+        entries[i].score[MIDDLEGAME] = 0;
+        entries[i].score[ENDGAME] = 0;
+    }
+    probes = 0;
+    hits = 0;
+}
+
+// @purpose: Looks up a Pawn structure in the table
+// @parameters: Pawn key of the position
+// @return: Entry of the Pawn structure, 0 if it is not in the table
+const PawnHashTable::Entry* PawnHashTable::probe(ZobristKey key)
+{
+    ++probes;
+
+    Entry& entry = entries[key & (numEntries - 1)];
+    if (entry.key != key)
+    {
+        return 0;
+    }
+
+    ++hits;
+    return &entry;
+}
+
+// @purpose: Saves the score of a Pawn structure, replacing whatever was in its entry
+// @parameters: Pawn key of the position, Middlegame score, Endgame score
+// @return: None
+void PawnHashTable::store(ZobristKey key, int middlegame, int endgame)
+{
+    Entry& entry = entries[key & (numEntries - 1)];
+    entry.key = key;
+    entry.score[MIDDLEGAME] = middlegame;
+    entry.score[ENDGAME] = endgame;
+}
+
+// @purpose: Get the number of lookups since the table was cleared
+// @parameters: None
+// @return: Number of calls to probe
+uint64_t PawnHashTable::getProbes()
+{
+    return probes;
+}
+
+// @purpose: Get the number of lookups that found their Pawn structure
+// @parameters: None
+// @return: Number of calls to probe that returned an entry
+uint64_t PawnHashTable::getHits()
+{
+    return hits;
+}
@@ -0,0 +1,89 @@
+//-------------------------------------------------------
+//
+// File: PawnHashTable.h
+// Author: Edward Koch
+// Description: Holds the declaration of the PawnHashTable Class
+//              The Pawn Hash Table remembers the Pawn structure score of positions by their Pawn key,
+//              a Zobrist key of only the Pawns. The Pawns move far less often than the other pieces,
+//              so most positions in a search share their Pawns with one that was already scored
+//              https://www.chessprogramming.org/Pawn_Hash_Table
+//              Each search thread has its own table, so the entries need no protection
+//
+// Revision History
+// Author    Date    Description
+//-------------------------------------------------------
+// E. Koch    10/17/26    Initial Creation of PawnHashTable class
+//-------------------------------------------------------
+#ifndef PAWN_HASH_TABLE_H
+#define PAWN_HASH_TABLE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ChessTypes.h"
+#include "EvaluationTypes.h"
+#include "Zobrist.h"
+
+class PawnHashTable
+{
+public:
+    // Size of the table when one is not given
+    static const int DefaultSizeMB = 1;
+
+    // The Pawn structure score of one position
+    struct Entry
+    {
+        ZobristKey key;
+        int score[NUM_PHASES]; // Score for White in each phase of the game
+    };
+
+    // @purpose: Construct a table of a given size
+    // @parameters: Size of the table in megabytes
+    // @return: None
+    PawnHashTable(int megabytes = DefaultSizeMB);
+
+    // Default Destructor
+    ~PawnHashTable();
+
+    // @purpose: Removes all entries from the table and resets the counts
+    // @parameters: None
+    // @return: None
+    void clear();
+
+    // @purpose: Looks up a Pawn structure in the table
+    // @parameters: Pawn key of the position
+    // @return: Entry of the Pawn structure, 0 if it is not in the table
+    const Entry* probe(ZobristKey key);
+
+    // @purpose: Saves the score of a Pawn structure, replacing whatever was in its entry
+    // @parameters: Pawn key of the position, Middlegame score, Endgame score
+    // @return: None
+    void store(ZobristKey key, int middlegame, int endgame);
+
+    // @purpose: Get the number of lookups since the table was cleared
+    // @parameters: None
+    // @return: Number of calls to probe
+    uint64_t getProbes();
+
+    // @purpose: Get the number of lookups that found their Pawn structure
+    // @parameters: None
+    // @return: Number of calls to probe that returned an entry
+    uint64_t getHits();
+
+private:
+    // Holds all of the entries
+    Entry* entries;
+
+    // Number of entries, always a power of two so that the index is a mask of the key
+    size_t numEntries;
+
+    // Counts of the lookups, to measure how well the table works
+    uint64_t probes;
+    uint64_t hits;
+
+    // The table owns its entries, so it can not be copied
+    PawnHashTable(const PawnHashTable&);
+    PawnHashTable& operator = (const PawnHashTable&);
+};
+
+#endif // PAWN_HASH_TABLE_H
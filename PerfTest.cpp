@@ -9,188 +9,1279 @@
 //-------------------------------------------------------
 // E. Koch    04/16/23    Initial Creation of PerfTest class
 //-------------------------------------------------------
+#include <algorithm>
+#include <atomic>
 #include <cctype>
-#include <time.h>
+#include <chrono>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "Board.h"
+#include "ChessAI.h"
 #include "Logger.h"
 #include "PerfTest.h"
+#include "PerftHashTable.h"
 #include "Piece.h"
 
 Board* PerfTest::board = 0;
+PerftHashTable* PerfTest::hashTable = 0;
+bool PerfTest::bulkCounting = false;
 
-// @purpose: Runs the PerfT function on all test fen to depth 3 - https://www.chessprogramming.org/Perft
-// @parameters: None
+// The Perft positions and their expected results - https://www.chessprogramming.org/Perft_Results
+// A result of 0 is not known
+static const int NUM_PERFT_POS = 6;
+static const char* perftFens[NUM_PERFT_POS] =
+{
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", // Position 1
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq -", // Position 2
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - ", // Position 3
+    "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1", // Position 4
+    "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8", // Position 5
+    "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10" // Position 6
+};
+static const long long perftResults[NUM_PERFT_POS][PerfTest::KNOWN_PERFT_DEPTH] =
+{
+    {20, 400,  8902,  197281,  4865609,   119060324,  3195901860},  // Position 1 depths 1, 2, 3, 4, 5, 6, 7
+    {48, 2039, 97862, 4085603, 193690690, 8031647685, 0},           // Position 2 depths 1, 2, 3, 4, 5, 6, 7
+    {14, 191,  2812,  43238,   674624,    11030083,   178633661},   // Position 3 depths 1, 2, 3, 4, 5, 6, 7
+    {6,  264,  9467,  422333,  15833292,  706045033,  0},           // Position 4 depths 1, 2, 3, 4, 5, 6, 7
+    {44, 1486, 62379, 2103487, 89941194,  0,          0},           // Position 5 depths 1, 2, 3, 4, 5, 6, 7
+    {46, 2079, 89890, 3894594, 164075551, 6923051137, 287188994746} // Position 6 depths 1, 2, 3, 4, 5, 6, 7
+};
+
+// Positions that the search is tested and benchmarked on - the Perft positions, and some with Black to move
+static const int NUM_SEARCH_POS = 10;
+static const char* searchFens[NUM_SEARCH_POS] =
+{
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", // Position 1
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq -", // Position 2
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - ", // Position 3
+    "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1", // Position 4
+    "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8", // Position 5
+    "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10", // Position 6
+    "rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1", // Position 1 after e4
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R b KQkq - 0 1", // Position 2 with Black to move
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 b - - 0 1", // Position 3 with Black to move
+    "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 b - - 0 10" // Position 6 with Black to move
+};
+
+// A position with only one correct move, so that a search that does not find it is wrong rather than different
+struct TacticalPosition
+{
+    const char* fen;
+    Squares start;
+    Squares end;
+    const char* description;
+};
+
+// Positions that the search is tested on - every mate is the only one, and every other move loses the material
+static const int NUM_TACTICAL_POS = 10;
+static const TacticalPosition tacticalPositions[NUM_TACTICAL_POS] =
+{
+    {"6k1/5ppp/8/8/8/8/5PPP/3R2K1 w - - 0 1", D1, D8, "Back rank mate in 1"},
+    {"3r2k1/5ppp/8/8/8/8/5PPP/6K1 b - - 0 1", D8, D1, "Back rank mate in 1 for Black"},
+    {"r1bqkb1r/pppp1ppp/2n2n2/4p2Q/2B1P3/8/PPPP1PPP/RNB1K1NR w KQkq - 4 4", H5, F7, "Scholar's mate"},
+    {"kbK5/pp6/1P6/8/8/8/8/R7 w - - 0 1", A1, A6, "Quiet move that mates in 2"},
+    {"r7/8/8/8/8/1p6/PP6/KBk5 b - - 0 1", A8, A3, "Quiet move that mates in 2 for Black"},
+    {"8/P7/8/8/8/8/8/k1K5 w - - 0 1", A7, A8, "Promotion that mates in 1 - other moves mate later"},
+    {"4k3/8/8/3q4/8/8/3R4/4K3 w - - 0 1", D2, D5, "Capture of an undefended Queen"},
+    {"4k3/3r4/8/8/3Q4/8/8/4K3 b - - 0 1", D7, D4, "Capture of an undefended Queen for Black"},
+    {"4k3/8/8/8/3n4/8/8/R3K3 b - - 0 1", D4, C2, "Knight fork of the King and Rook"},
+    {"r3k2r/ppp2ppp/8/3N4/8/8/PPP2PPP/4K3 w kq - 0 1", D5, C7, "Knight capture that forks the King and both Rooks"}
+};
+
+// @purpose: Calculates a speed without overflowing on long runs
+// @parameters: Number of Nodes, Time in nanoseconds
+// @return: Nodes per second, 0 if no time was measured
+static long long nodesPerSecond(long long nodes, long long nanoseconds)
+{
+    return (nanoseconds > 0) ? (long long)(nodes * 1000000000.0 / nanoseconds) : 0;
+}
+
+// One subtree of a parallel perft - a root move, and a reply to it when the tree is split two plies deep
+struct PerftTask
+{
+    int rootIndex;
+    PackedMove rootMove;
+    PackedMove reply;
+    bool hasReply;
+    long long nodes;
+};
+
+// The tasks waiting for one thread - it takes from the front, and idle threads steal from the back
+struct PerftQueue
+{
+    std::mutex lock;
+    std::deque<int> tasks;
+};
+
+// The work shared by all threads of a parallel perft
+// No task is added once the threads start, so a thread that finds every queue empty is done
+struct ParallelPerft
+{
+    std::vector<PerftTask> tasks;
+    std::vector<PerftQueue> queues;
+    int depth;
+};
+
+// @purpose: Counts the subtrees of a parallel perft until there are none left to take or steal
+// @parameters: Work shared by the threads, Number of this thread, Board of this thread
 // @return: None
-void PerfTest::runAllPerft()
+static void perftWorker(ParallelPerft* work, int threadId, Board* workerBoard)
 {
-    int totalNodes = 0;
-    int totalTime = 0;
+    int numQueues = (int)work->queues.size();
 
-    const int NUM_POS = 6;
-    const char* fens[NUM_POS] =
+    while (true)
     {
-        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", // Position 1
-        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq -", // Position 2
-        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - ", // Position 3
-        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1", // Position 4
-        "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8", // Position 5
-        "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10" // Position 6
-    };
+        // Take from this thread's own queue first, then steal from the others
+        int task = -1;
+        for (int i = 0; i < numQueues && task < 0; ++i)
+        {
+            PerftQueue& queue = work->queues[(threadId + i) % numQueues];
+            std::lock_guard<std::mutex> guard(queue.lock);
+            if (!queue.tasks.empty())
+            {
+                if (i == 0)
+                {
+                    task = queue.tasks.front();
+                    queue.tasks.pop_front();
+                }
+                else
+                {
+                    task = queue.tasks.back();
+                    queue.tasks.pop_back();
+                }
+            }
+        }
+
+        if (task < 0)
+        {
+            return;
+        }
 
-    // Expected Results from  - https://www.chessprogramming.org/Perft
-    const int DEPTH = 5;
-    const int results[NUM_POS][DEPTH] =
+        // Every task has its own result, so no lock is needed to write it
+        PerftTask& perftTask = work->tasks[task];
+        workerBoard->makeMove(perftTask.rootMove);
+        if (perftTask.hasReply)
+        {
+            workerBoard->makeMove(perftTask.reply);
+        }
+
+        perftTask.nodes = PerfTest::perft(workerBoard, work->depth, workerBoard->getFen()->activeColor);
+
+        if (perftTask.hasReply)
+        {
+            workerBoard->undoMove();
+        }
+        workerBoard->undoMove();
+    }
+}
+
+// One position of a Perft suite, and how far it matched its expected counts
+struct SuitePosition
+{
+    std::string fen;
+    std::vector<long long> expected; // Expected count at each depth from 1, 0 if the suite does not give one
+    int failedDepth;                 // Smallest depth that did not match, 0 if every depth did
+    long long nodes;                 // Count at the failed depth
+};
+
+// @purpose: Runs the positions of a Perft suite until every position has been taken by a thread
+// @parameters: Positions of the suite, Index of the next position to take, deepest depth to run
+// @return: None
+static void suiteWorker(std::vector<SuitePosition>* positions, std::atomic<int>* nextPosition, int maxDepth)
+{
+    int index;
+    while ((index = nextPosition->fetch_add(1)) < (int)positions->size())
     {
-        {20, 400,  8902,  197281,  4865609},  // Position 1 depths 1, 2, 3, 4, 5
-        {48, 2039, 97862, 4085603, 193690690},// Position 2 depths 1, 2, 3, 4, 5
-        {14, 191,  2812,  43238,   674624},   // Position 3 depths 1, 2, 3, 4, 5
-        {6,  264,  9467,  422333,  15833292}, // Position 4 depths 1, 2, 3, 4, 5
-        {44, 1486, 62379, 2103487, 89941194}, // Position 5 depths 1, 2, 3, 4, 5
-        {46, 2079, 89890, 3894594, 164075551} // Position 6 depths 1, 2, 3, 4, 5
-    };
+        SuitePosition& position = (*positions)[index];
+        Board board(position.fen.c_str());
+        Colors color = board.getFen()->activeColor;
 
-    for (int position = 0; position < NUM_POS; ++position)
+        // The shallowest failing depth is the quickest to narrow down, so stop at the first
+        int depths = std::min((int)position.expected.size(), maxDepth);
+        for (int depth = 1; depth <= depths && position.failedDepth == 0; ++depth)
+        {
+            if (position.expected[depth - 1] == 0)
+            {
+                continue;
+            }
+
+            long long nodes = PerfTest::perft(&board, depth, color);
+            if (nodes != position.expected[depth - 1])
+            {
+                position.failedDepth = depth;
+                position.nodes = nodes;
+            }
+        }
+    }
+}
+
+// @purpose: Checks if a move is in a list
+// @parameters: List of moves, Move to find
+// @return: true if the list holds the move, false otherwise
+static bool containsMove(MoveList& moves, PackedMove move)
+{
+    return std::find(moves.begin(), moves.end(), move) != moves.end();
+}
+
+// @purpose: Runs the PerfT function on all test fen, checking the counts against the known results
+//           https://www.chessprogramming.org/Perft_Results
+//           Depths without a known result are skipped
+// @parameters: deepest depth to run, at most KNOWN_PERFT_DEPTH
+// @return: None
+void PerfTest::runAllPerft(int maxDepth)
+{
+    long long totalNodes = 0;
+    long long totalNanoseconds = 0;
+
+    maxDepth = std::min(maxDepth, KNOWN_PERFT_DEPTH);
+
+    for (int position = 0; position < NUM_PERFT_POS; ++position)
     {
-        for (int depth = 0; depth < DEPTH; ++depth)
+        for (int depth = 0; depth < maxDepth; ++depth)
         {
-            if (results[position][depth] > 10000000)
+            if (perftResults[position][depth] == 0)
             {
-                Logger::enable();
-                Logger::log("Position %i at depth %i is too long\n", position + 1, depth + 1);
-                Logger::restore();
                 continue;
             }
-            Logger::disable();
+
             // Time the execution
-            time_t start;
-            time_t stop;
-            time(&start);
-            int numNodes = runPerft(fens[position], depth+1);
-            time(&stop);
-            int execution = difftime(stop, start);
-            int mins = execution / 60;
-            int secs = execution % 60;
+            long long numNodes = 0;
+            long long execution = timePerft(perftFens[position], depth + 1, numNodes);
             Logger::enable();
-            if (numNodes == results[position][depth])
+            if (numNodes == perftResults[position][depth])
             {
-                Logger::log("Position %i at depth %i PASSED! %i Nodes in %i min %i sec\n", position + 1, depth + 1, numNodes, mins, secs);
+                Logger::log("Position %i at depth %i PASSED! %lld Nodes in %.3f ms\n",
+                    position + 1, depth + 1, numNodes, execution / 1000000.0);
             }
             else
             {
-                Logger::log("Position %i at depth %i FAILED - %i/%i in %i min %i sec\n", position+1, depth+1, numNodes, results[position][depth], mins, secs);
+                Logger::log("Position %i at depth %i FAILED - %lld/%lld in %.3f ms\n",
+                    position + 1, depth + 1, numNodes, perftResults[position][depth], execution / 1000000.0);
                 // Run test again with output
-                runPerft(fens[position], depth + 1);
+                runPerft(perftFens[position], depth + 1);
                 Logger::log("\n\n");
             }
+            logPerftHashStats();
+            Logger::restore();
 
             totalNodes += numNodes;
-            totalTime += execution;
+            totalNanoseconds += execution;
         }
     }
     Logger::enable();
-    Logger::log("Average Nodes/Second = %d\n", totalNodes / totalTime);
+    Logger::log("Average Nodes/Second = %lld\n", nodesPerSecond(totalNodes, totalNanoseconds));
     Logger::restore();
 }
 
+// @purpose: Times perft on the test fens to every depth up to a limit, repeating each run to measure its speed
+//           The counts are checked against the known results, so that it can gate a change to the move generation
+// @parameters: deepest depth to run (at most KNOWN_PERFT_DEPTH), times to run each position and depth,
+//              format of the machine readable report, file to write the report to - the console if null
+// @return: true if every count matched its known result
+bool PerfTest::runPerftBenchmark(int maxDepth, int runs, ReportFormats format, const char* reportFile)
+{
+    maxDepth = std::min(maxDepth, KNOWN_PERFT_DEPTH);
+    runs = std::max(runs, 1);
+
+    // The results of one position at one depth
+    struct BenchmarkResult
+    {
+        int position;
+        int depth;
+        long long nodes;
+        bool passed;
+        long long minNanoseconds;
+        long long medianNanoseconds;
+    };
+    std::vector<BenchmarkResult> results;
+
+    bool allPassed = true;
+    long long totalNodes = 0;
+    long long totalNanoseconds = 0;
+    std::vector<long long> times(runs);
+
+    for (int position = 0; position < NUM_PERFT_POS; ++position)
+    {
+        for (int depth = 0; depth < maxDepth; ++depth)
+        {
+            if (perftResults[position][depth] == 0)
+            {
+                continue;
+            }
+
+            BenchmarkResult result;
+            result.position = position + 1;
+            result.depth = depth + 1;
+            result.passed = true;
+
+            for (int run = 0; run < runs; ++run)
+            {
+                times[run] = timePerft(perftFens[position], depth + 1, result.nodes);
+                result.passed = result.passed && (result.nodes == perftResults[position][depth]);
+            }
+
+            // The median is less affected than the mean by a run that the system slowed down
+            std::sort(times.begin(), times.end());
+            result.minNanoseconds = times[0];
+            result.medianNanoseconds = (runs % 2) ? times[runs / 2] : (times[runs / 2 - 1] + times[runs / 2]) / 2;
+
+            allPassed = allPassed && result.passed;
+            totalNodes += result.nodes;
+            totalNanoseconds += result.medianNanoseconds;
+            results.push_back(result);
+
+            Logger::enable();
+            Logger::log("Position %i at depth %i %s %12lld Nodes - min %10.3f ms, median %10.3f ms, %10lld Nodes/Second\n",
+                result.position, result.depth, result.passed ? "PASSED!" : "FAILED ", result.nodes,
+                result.minNanoseconds / 1000000.0, result.medianNanoseconds / 1000000.0,
+                nodesPerSecond(result.nodes, result.medianNanoseconds));
+            Logger::restore();
+        }
+    }
+
+    long long totalNodesPerSecond = nodesPerSecond(totalNodes, totalNanoseconds);
+    Logger::enable();
+    Logger::log("Perft Benchmark %s%s - %lld Nodes in %.3f ms, %lld Nodes/Second\n",
+        allPassed ? "PASSED" : "FAILED", bulkCounting ? " with bulk counting" : "", totalNodes, totalNanoseconds / 1000000.0, totalNodesPerSecond);
+    Logger::restore();
+
+    if (format == REPORT_NONE)
+    {
+        return allPassed;
+    }
+
+    // Write the report to the file if there is one, otherwise to the console
+    std::ofstream file;
+    if (reportFile)
+    {
+        file.open(reportFile);
+    }
+    std::ostream& report = (reportFile && file.is_open()) ? file : std::cout;
+    report << std::fixed << std::setprecision(3);
+
+    if (format == REPORT_CSV)
+    {
+        report << "position,depth,nodes,expected,passed,runs,min_ms,median_ms,nps\n";
+        for (std::vector<BenchmarkResult>::iterator it = results.begin(); it != results.end(); ++it)
+        {
+            report << it->position << "," << it->depth << "," << it->nodes << ","
+                << perftResults[it->position - 1][it->depth - 1] << "," << (it->passed ? "true" : "false") << ","
+                << runs << "," << it->minNanoseconds / 1000000.0 << "," << it->medianNanoseconds / 1000000.0 << ","
+                << nodesPerSecond(it->nodes, it->medianNanoseconds) << "\n";
+        }
+    }
+    else if (format == REPORT_JSON)
+    {
+        report << "{\n";
+        report << "  \"runs\": " << runs << ",\n";
+        report << "  \"bulk_counting\": " << (bulkCounting ? "true" : "false") << ",\n";
+        report << "  \"passed\": " << (allPassed ? "true" : "false") << ",\n";
+        report << "  \"nodes\": " << totalNodes << ",\n";
+        report << "  \"median_ms\": " << totalNanoseconds / 1000000.0 << ",\n";
+        report << "  \"nps\": " << totalNodesPerSecond << ",\n";
+        report << "  \"results\": [\n";
+        for (std::vector<BenchmarkResult>::iterator it = results.begin(); it != results.end(); ++it)
+        {
+            report << "    { \"position\": " << it->position << ", \"depth\": " << it->depth
+                << ", \"nodes\": " << it->nodes << ", \"expected\": " << perftResults[it->position - 1][it->depth - 1]
+                << ", \"passed\": " << (it->passed ? "true" : "false")
+                << ", \"min_ms\": " << it->minNanoseconds / 1000000.0 << ", \"median_ms\": " << it->medianNanoseconds / 1000000.0
+                << ", \"nps\": " << nodesPerSecond(it->nodes, it->medianNanoseconds)
+                << " }" << ((it + 1 != results.end()) ? "," : "") << "\n";
+        }
+        report << "  ]\n";
+        report << "}\n";
+    }
+    report.flush();
+
+    return allPassed;
+}
+
 // @purpose: Runs the PerfT function on a given fen
 // @parameters: fen string, depth to run
-// @return: Number of Nodes
-int PerfTest::runPerft(const char* fen, int depth)
+// @return: Number of Nodes, 0 if the depth is not positive
+long long PerfTest::runPerft(const char* fen, int depth)
 {
+    // A divide lists the nodes below each root move, so it needs at least one ply
+    if (depth <= 0)
+    {
+        Logger::log("Perft depth %i is not positive\n", depth);
+        return 0;
+    }
+
     Board newBoard(fen);
     board = &newBoard;
 
+    if (hashTable)
+    {
+        hashTable->clear();
+    }
+
     Colors startingColor = board->getFen()->activeColor;
 
-    int depthNodes = 0;
+    long long depthNodes = 0;
 
     // Time the execution
-    time_t start;
-    time_t stop;
-    time(&start);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
 
     // Get all of Whites moves
-    mvVector allMoves = *board->getAllMoves(startingColor);
+    MoveList allMoves = *board->getAllMoves(startingColor);
 
     // Loop through all possible moves for White
-    for (mvVector::iterator it = allMoves.begin(); it != allMoves.end(); ++it)
+    for (MoveList::iterator it = allMoves.begin(); it != allMoves.end(); ++it)
     {
         // Make a candiate move
         board->makeMove(*it);
 
         // Count the number of sub-nodes
-        int moveNodes = perft(depth - 1, Chess::enemy[startingColor]);
+        long long moveNodes = perft(depth - 1, Chess::enemy[startingColor]);
 
         // Undo the move
         board->undoMove();
 
         // Print the initial move
         //Logger::enable();
-        //if (it->pieceMoved->getType() != PAWN)
-        //{
-        //    Logger::log("%c", toupper(it->pieceMoved->getCharId()));
-        //}
-        Logger::log("%c%c", tolower(Chess::File[it->start % Chess::NumFiles]),
-            Chess::Rank[it->start / Chess::NumRanks]);
-        Logger::log("%c%c", tolower(Chess::File[it->end % Chess::NumFiles]),
-            Chess::Rank[it->end / Chess::NumRanks]);
+        it->printMove();
 
         // Print the number of nodes that came from that first move
-        Logger::log(": %i\n", moveNodes);
+        Logger::log(": %lld\n", moveNodes);
 
         depthNodes += moveNodes;
     }
 
-    time(&stop);
-    int execution = difftime(stop, start);
-    int mins = execution / 60;
-    int secs = execution % 60;
+    long long execution = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    long long mins = execution / 60000;
+    long long secs = (execution / 1000) % 60;
+    long long millis = execution % 1000;
 
     //Logger::enable();
-    Logger::log("%i Nodes at Depth %i in% i min% i sec\n", depthNodes, depth, mins, secs);
+    Logger::log("%lld Nodes at Depth %i in %lld min %lld.%03lld sec\n", depthNodes, depth, mins, secs, millis);
+    logPerftHashStats();
+
+    return depthNodes;
+}
+
+// @purpose: Runs the PerfT function on a given fen on several threads, each with its own Board
+//           The subtrees below the root are shared out between the threads, which steal from each other when they run out
+// @parameters: fen string, depth to run, number of threads - every hardware thread if 0
+// @return: Number of Nodes, 0 if the depth is not positive
+long long PerfTest::runParallelPerft(const char* fen, int depth, int threads)
+{
+    // The threads count the subtrees below the root moves, so there must be at least one ply
+    if (depth <= 0)
+    {
+        Logger::log("Perft depth %i is not positive\n", depth);
+        return 0;
+    }
+
+    if (threads <= 0)
+    {
+        threads = std::max((int)std::thread::hardware_concurrency(), 1);
+    }
+
+    // Building the Boards prints them, so keep that out of the divide
+    Logger::disable();
+    Board rootBoard(fen);
+    std::vector<Board*> boards;
+    for (int i = 0; i < threads; ++i)
+    {
+        boards.push_back(new Board(fen));
+    }
+    Logger::restore();
+
+    if (hashTable)
+    {
+        hashTable->clear();
+    }
+
+    Colors startingColor = rootBoard.getFen()->activeColor;
+
+    // Time the execution
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    // Split the tree below every reply to the root moves when it is deep enough,
+    // since a few root moves can hold most of the nodes and leave the other threads idle
+    MoveList rootMoves = *rootBoard.getAllMoves(startingColor);
+    bool splitReplies = (depth >= 3);
+
+    ParallelPerft work;
+    work.depth = splitReplies ? depth - 2 : depth - 1;
+    for (int rootIndex = 0; rootIndex < rootMoves.size(); ++rootIndex)
+    {
+        PerftTask task;
+        task.rootIndex = rootIndex;
+        task.rootMove = rootMoves[rootIndex];
+        task.hasReply = false;
+        task.nodes = 0;
+
+        if (!splitReplies)
+        {
+            work.tasks.push_back(task);
+            continue;
+        }
+
+        rootBoard.makeMove(task.rootMove);
+        MoveList replies = *rootBoard.getAllMoves(Chess::enemy[startingColor]);
+        for (MoveList::iterator it = replies.begin(); it != replies.end(); ++it)
+        {
+            task.reply = *it;
+            task.hasReply = true;
+            work.tasks.push_back(task);
+        }
+        rootBoard.undoMove();
+    }
+
+    // Deal the tasks out in turn, so that every thread starts with subtrees of every root move
+    work.queues = std::vector<PerftQueue>(threads);
+    for (int i = 0; i < (int)work.tasks.size(); ++i)
+    {
+        work.queues[i % threads].tasks.push_back(i);
+    }
+
+    std::vector<std::thread> workers;
+    for (int i = 0; i < threads; ++i)
+    {
+        workers.push_back(std::thread(perftWorker, &work, i, boards[i]));
+    }
+    for (std::vector<std::thread>::iterator it = workers.begin(); it != workers.end(); ++it)
+    {
+        it->join();
+    }
+
+    // Add up the subtrees of each root move
+    std::vector<long long> moveNodes(rootMoves.size(), 0);
+    for (std::vector<PerftTask>::iterator it = work.tasks.begin(); it != work.tasks.end(); ++it)
+    {
+        moveNodes[it->rootIndex] += it->nodes;
+    }
+
+    long long execution = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+    long long depthNodes = 0;
+    for (int rootIndex = 0; rootIndex < rootMoves.size(); ++rootIndex)
+    {
+        // Print the initial move, and the number of nodes that came from it
+        rootMoves[rootIndex].printMove();
+        Logger::log(": %lld\n", moveNodes[rootIndex]);
+
+        depthNodes += moveNodes[rootIndex];
+    }
+
+    long long mins = execution / 60000;
+    long long secs = (execution / 1000) % 60;
+    long long millis = execution % 1000;
+
+    Logger::log("%lld Nodes at Depth %i in %lld min %lld.%03lld sec on %i threads\n", depthNodes, depth, mins, secs, millis, threads);
+    logPerftHashStats();
+
+    for (std::vector<Board*>::iterator it = boards.begin(); it != boards.end(); ++it)
+    {
+        delete *it;
+    }
 
     return depthNodes;
 }
 
+// @purpose: Runs perft on every position of an EPD file on several threads, checking the counts the file expects
+//           Each line is a fen followed by its expected counts, such as "<fen> ;D1 20 ;D2 400 ;D3 8902"
+//           A position that fails is narrowed down to the move where its counts first go wrong
+// @parameters: EPD file, deepest depth to run, number of threads - every hardware thread if 0
+// @return: true if every count matched
+bool PerfTest::runPerftSuite(const char* epdFile, int maxDepth, int threads)
+{
+    std::ifstream file(epdFile);
+    if (!file.is_open())
+    {
+        Logger::log("Could not open Perft suite %s\n", epdFile);
+        return false;
+    }
+
+    std::vector<SuitePosition> positions;
+    std::string line;
+    while (std::getline(file, line))
+    {
+        // The fen ends at the first field of expected counts
+        size_t field = line.find(';');
+        SuitePosition position;
+        position.fen = line.substr(0, field);
+        position.fen.erase(position.fen.find_last_not_of(" \t\r") + 1);
+        position.failedDepth = 0;
+        position.nodes = 0;
+
+        if (position.fen.empty() || position.fen[0] == '#')
+        {
+            continue;
+        }
+
+        while (field != std::string::npos)
+        {
+            size_t nextField = line.find(';', field + 1);
+            std::istringstream count(line.substr(field + 1, nextField - field - 1));
+
+            char depthChar;
+            int depth;
+            long long nodes;
+            if ((count >> depthChar >> depth >> nodes) && toupper(depthChar) == 'D' && depth > 0)
+            {
+                if ((int)position.expected.size() < depth)
+                {
+                    position.expected.resize(depth, 0);
+                }
+                position.expected[depth - 1] = nodes;
+            }
+            field = nextField;
+        }
+
+        positions.push_back(position);
+    }
+
+    if (threads <= 0)
+    {
+        threads = std::max((int)std::thread::hardware_concurrency(), 1);
+    }
+    threads = std::max(std::min(threads, (int)positions.size()), 1);
+
+    if (hashTable)
+    {
+        hashTable->clear();
+    }
+
+    // The threads build their own Boards, which would print over each other
+    // Building one first also fills the shared tables before the threads need them
+    Logger::disable();
+    Board firstBoard;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    // Each thread takes the next position that no thread has started, so a slow position does not hold up the rest
+    std::atomic<int> nextPosition(0);
+    std::vector<std::thread> workers;
+    for (int i = 0; i < threads; ++i)
+    {
+        workers.push_back(std::thread(suiteWorker, &positions, &nextPosition, maxDepth));
+    }
+    for (std::vector<std::thread>::iterator it = workers.begin(); it != workers.end(); ++it)
+    {
+        it->join();
+    }
+
+    long long execution = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    Logger::restore();
+
+    int passed = 0;
+    for (int i = 0; i < (int)positions.size(); ++i)
+    {
+        SuitePosition& position = positions[i];
+        if (position.failedDepth == 0)
+        {
+            ++passed;
+            continue;
+        }
+
+        Logger::log("Position %i FAILED at depth %i - %lld/%lld: %s\n", i + 1, position.failedDepth,
+            position.nodes, position.expected[position.failedDepth - 1], position.fen.c_str());
+    }
+
+    Logger::log("Perft Suite %s - %i/%i positions passed to depth %i in %lld.%03lld sec on %i threads\n",
+        (passed == (int)positions.size()) ? "PASSED" : "FAILED", passed, (int)positions.size(), maxDepth,
+        execution / 1000, execution % 1000, threads);
+    logPerftHashStats();
+
+    for (std::vector<SuitePosition>::iterator it = positions.begin(); it != positions.end(); ++it)
+    {
+        if (it->failedDepth != 0)
+        {
+            findPerftMismatch(it->fen.c_str(), it->failedDepth);
+        }
+    }
+
+    return passed == (int)positions.size();
+}
+
 // @purpose: Counts the nodes at a given depth - used to test move generation
 // @parameters: int depth, color to search for
 // @return: None
-int PerfTest::perft(int depth, Colors color)
+long long PerfTest::perft(int depth, Colors color)
+{
+    return perft(board, depth, color);
+}
+
+// @purpose: Counts the nodes at a given depth on a given Board - so that several threads can count at once
+// @parameters: Board to count on, int depth, color to calculate for
+// @return: Number of Nodes
+long long PerfTest::perft(Board* perftBoard, int depth, Colors color)
 {
-    if (depth == 0)
+    // Count the lookups of this run apart from any other thread, and add them to the table once at the end
+    PerftHashTable::Counts counts;
+    long long nodes = countNodes(perftBoard, depth, color, counts);
+    if (hashTable)
+    {
+        hashTable->addCounts(counts);
+    }
+
+    return nodes;
+}
+
+// @purpose: Counts the nodes at a given depth on a given Board, counting the Perft Hash Table lookups it makes
+// @parameters: Board to count on, int depth, color to calculate for, Lookups of the calling thread
+// @return: Number of Nodes
+long long PerfTest::countNodes(Board* perftBoard, int depth, Colors color, PerftHashTable::Counts& counts)
+{
+    // The position itself is the only node left - a depth below 0 would never get back to 0
+    if (depth <= 0)
     {
         return 1;
     }
 
+    // Every legal move is one node, so there is no need to make them
+    if (bulkCounting && depth == 1)
+    {
+        return perftBoard->getAllMoves(color)->size();
+    }
+
     // Track the number of nodes
-    int nodes = 0;
+    long long nodes = 0;
+
+    // A subtree reached by another move order has already been counted
+    // Looking up a single move costs more than making it, so only deeper subtrees are remembered
+    bool useHash = (hashTable && depth >= 2);
+    if (useHash && hashTable->probe(perftBoard->getHash(), depth, nodes, counts))
+    {
+        return nodes;
+    }
 
     // Get all of Whites moves
-    mvVector allMoves = *board->getAllMoves(color);
+    MoveList allMoves = *perftBoard->getAllMoves(color);
 
     // Loop through all possible moves for White
-    for (mvVector::iterator it = allMoves.begin(); it != allMoves.end(); ++it)
+    for (MoveList::iterator it = allMoves.begin(); it != allMoves.end(); ++it)
     {
         // Make a candiate move
-        board->makeMove(*it);
+        perftBoard->makeMove(*it);
         // Count the number of sub-nodes
-        nodes += perft(depth - 1, Chess::enemy[color]);
+        nodes += countNodes(perftBoard, depth - 1, Chess::enemy[color], counts);
 
         // Undo the move
-        board->undoMove();
+        perftBoard->undoMove();
+    }
+
+    if (useHash)
+    {
+        hashTable->store(perftBoard->getHash(), depth, nodes);
+    }
+
+    return nodes;
+}
+
+// @purpose: Times one perft run without any output, leaving the Logger as it was
+// @parameters: fen string, depth to run, Number of Nodes to fill
+// @return: Time of the run in nanoseconds - only the counting, not setting up the board
+long long PerfTest::timePerft(const char* fen, int depth, long long& nodes)
+{
+    Logger::disable();
+    Board newBoard(fen);
+    board = &newBoard;
+
+    if (hashTable)
+    {
+        hashTable->clear();
+    }
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    nodes = perft(depth, board->getFen()->activeColor);
+    std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+
+    board = 0;
+    Logger::restore();
+
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count();
+}
+
+// @purpose: Turns on the Perft Hash Table, so that subtrees reached by transposition are only counted once
+//           Every perft run starts with an empty table
+// @parameters: Size of the table in megabytes, 0 to turn it off
+// @return: None
+void PerfTest::setPerftHashSize(int megabytes)
+{
+    delete hashTable;
+    hashTable = (megabytes > 0) ? new PerftHashTable(megabytes) : 0;
+}
+
+// @purpose: Turns on bulk counting, where a position one ply from the end counts its legal moves
+//           instead of making and undoing each of them - off to check making and undoing every move
+// @parameters: true to count in bulk, false to make every move
+// @return: None
+void PerfTest::setBulkCounting(bool enabled)
+{
+    bulkCounting = enabled;
+}
+
+// @purpose: Logs how often the Perft Hash Table found a subtree, if it is on
+// @parameters: None
+// @return: None
+void PerfTest::logPerftHashStats()
+{
+    if (!hashTable)
+    {
+        return;
+    }
+
+    uint64_t probes = hashTable->getProbes();
+    uint64_t hits = hashTable->getHits();
+    Logger::log("Perft Hash Table (%i MB) hits: %llu/%llu (%i%%)\n", hashTable->getSizeMB(),
+        (unsigned long long)hits, (unsigned long long)probes, (probes > 0) ? (int)(100 * hits / probes) : 0);
+}
+
+// @purpose: Counts the nodes at a given depth by making every move on a copy of its Board, instead of making and
+//           undoing moves on one Board - a reference for any state that the Board carries between moves
+// @parameters: fen string, depth to run
+// @return: Number of Nodes
+long long PerfTest::referencePerft(const char* fen, int depth)
+{
+    Board fenBoard(fen);
+    return referencePerft(fenBoard, depth);
+}
+
+// @purpose: Counts the nodes at a given depth by making every move on a copy of the Board
+// @parameters: Board of the position, depth to run
+// @return: Number of Nodes
+long long PerfTest::referencePerft(Board& position, int depth)
+{
+    MoveList moves = *position.getAllMoves(position.getFen()->activeColor);
+    if (depth <= 1)
+    {
+        return (depth == 1) ? moves.size() : 1;
+    }
+
+    // A copy builds its bitboards from the pieces and is never undone, so it only carries the position itself
+    // Every copy is thrown away after one move, so none of them reserve room for a search
+    long long nodes = 0;
+    for (MoveList::iterator it = moves.begin(); it != moves.end(); ++it)
+    {
+        Board moveBoard(position, false);
+        moveBoard.makeMove(*it);
+
+        // Making the move can leave stale state behind as well, so count on a copy of the position it reached
+        Board reached(moveBoard, false);
+        nodes += referencePerft(reached, depth - 1);
     }
 
     return nodes;
 }
 
+// @purpose: Narrows a failing perft down to the move where the counts first go wrong, by comparing the Board
+//           reached by making moves against a Board built from the same fen at every step down the divide
+// @parameters: fen string of the failing position, smallest depth that fails
+// @return: None
+void PerfTest::findPerftMismatch(const char* fen, int depth)
+{
+    // A remembered count would be found for both ways of counting, and hide any difference between them
+    PerftHashTable* table = hashTable;
+    hashTable = 0;
+
+    Logger::log("Narrowing down %s at depth %i\n", fen, depth);
+
+    Logger::disable();
+    Board* played = new Board(fen);
+    Logger::restore();
+
+    std::string parentFen;
+    std::string currentFen;
+    PackedMove lastMove;
+    bool found = false;
+
+    while (!found)
+    {
+        Colors color = played->getFen()->activeColor;
+        currentFen = played->getFenString();
+
+        Logger::disable();
+        Board built(currentFen.c_str());
+        Logger::restore();
+
+        MoveList moves = *played->getAllMoves(color);
+        MoveList builtMoves = *built.getAllMoves(color);
+
+        // The position reached by making moves must be the same as the one built from its fen
+        bool sameMoves = (moves.size() == builtMoves.size());
+        for (MoveList::iterator it = moves.begin(); it != moves.end() && sameMoves; ++it)
+        {
+            sameMoves = containsMove(builtMoves, *it);
+        }
+
+        if (!sameMoves || played->getHash() != built.getHash() || played->getOccupancy() != built.getOccupancy())
+        {
+            if (lastMove.isNull())
+            {
+                Logger::log("The position does not match itself built from its fen: %s\n", currentFen.c_str());
+            }
+            else
+            {
+                Logger::log("Making ");
+                lastMove.printMove();
+                Logger::log(" in %s\nreaches a position that does not match %s\n", parentFen.c_str(), currentFen.c_str());
+            }
+
+            if (played->getHash() != built.getHash())
+            {
+                Logger::log("The Zobrist keys differ\n");
+            }
+            if (played->getOccupancy() != built.getOccupancy())
+            {
+                Logger::log("The occupied squares differ\n");
+            }
+            for (MoveList::iterator it = moves.begin(); it != moves.end(); ++it)
+            {
+                if (!containsMove(builtMoves, *it))
+                {
+                    Logger::log("Extra move ");
+                    it->printMove();
+                    Logger::log("\n");
+                }
+            }
+            for (MoveList::iterator it = builtMoves.begin(); it != builtMoves.end(); ++it)
+            {
+                if (!containsMove(moves, *it))
+                {
+                    Logger::log("Missing move ");
+                    it->printMove();
+                    Logger::log("\n");
+                }
+            }
+            found = true;
+            break;
+        }
+
+        if (depth <= 0)
+        {
+            break;
+        }
+
+        // Find the move whose subtree counts differ from counting every position built from its fen,
+        // or that leaves the position changed once it and its subtree are undone
+        PackedMove failingMove;
+        bool restored = true;
+        for (MoveList::iterator it = moves.begin(); it != moves.end(); ++it)
+        {
+            ZobristKey key = played->getHash();
+            Bitboard occupied = played->getOccupancy();
+            played->makeMove(*it);
+            std::string childFen = played->getFenString();
+            long long nodes = perft(played, depth - 1, Chess::enemy[color]);
+            played->undoMove();
+
+            if (played->getHash() != key || played->getOccupancy() != occupied || currentFen != played->getFenString())
+            {
+                failingMove = *it;
+                restored = false;
+                break;
+            }
+
+            // Copying the Board for every position of the subtree leaves nothing carried between moves to go wrong
+            Logger::disable();
+            long long reference = referencePerft(childFen.c_str(), depth - 1);
+            Logger::restore();
+
+            if (nodes != reference)
+            {
+                failingMove = *it;
+                break;
+            }
+        }
+
+        if (failingMove.isNull())
+        {
+            break;
+        }
+
+        if (!restored)
+        {
+            // Make and undo the move alone on a new Board, to tell a move that does not undo from one in its subtree
+            Logger::disable();
+            Board single(currentFen.c_str());
+            Logger::restore();
+
+            ZobristKey key = single.getHash();
+            Bitboard occupied = single.getOccupancy();
+            std::string singleFen = single.getFenString();
+            single.makeMove(failingMove);
+            single.undoMove();
+
+            if (single.getHash() != key || single.getOccupancy() != occupied || singleFen != single.getFenString())
+            {
+                Logger::log("Undoing ");
+                failingMove.printMove();
+                Logger::log(" does not restore %s\nit leaves %s\n", currentFen.c_str(), single.getFenString());
+                if (single.getHash() != key)
+                {
+                    Logger::log("The Zobrist keys differ\n");
+                }
+                if (single.getOccupancy() != occupied)
+                {
+                    Logger::log("The occupied squares differ\n");
+                }
+                found = true;
+                break;
+            }
+
+            // The move undoes cleanly on its own, so a move in its subtree does not - start again from the position before it
+            delete played;
+            Logger::disable();
+            played = new Board(currentFen.c_str());
+            Logger::restore();
+        }
+
+        parentFen = currentFen;
+        lastMove = failingMove;
+        played->makeMove(failingMove);
+        --depth;
+    }
+
+    if (!found)
+    {
+        // Both ways of counting agree, so the moves themselves are wrong and need a reference engine to compare the divide with
+        Logger::log("Every move agrees with counting positions built from their fen, so the move generation itself differs from the expected count\n");
+        if (depth > 0)
+        {
+            Logger::log("Divide of %s at depth %i:\n", currentFen.c_str(), depth);
+            runPerft(currentFen.c_str(), depth);
+        }
+    }
+
+    delete played;
+    hashTable = table;
+}
+
+// @purpose: Runs the ChessAI on test fens to fixed depths, checking that it still finds the moves of the
+//           White/Black MiniMax search that Negamax replaced
+//           Used to check that a change to the search does not change its result
+// @parameters: None
+// @return: None
+void PerfTest::runSearchTest()
+{
+    // Expected best moves from the White/Black MiniMax search that Negamax replaced
+    // These are never recorded again - a change that is meant to pick a different move says which in its commit
+    const int FIRST_DEPTH = 4;
+    const int DEPTH = 2;
+    const Squares results[NUM_SEARCH_POS][DEPTH][2] =
+    {
+        {{B1, C3}, {E2, E4}}, // Position 1 depths 4, 5
+        {{E2, A6}, {D5, E6}}, // Position 2 depths 4, 5
+        {{B4, F4}, {B4, F4}}, // Position 3 depths 4, 5
+        {{G1, H1}, {C4, C5}}, // Position 4 depths 4, 5
+        {{D7, C8}, {D7, C8}}, // Position 5 depths 4, 5
+        {{C3, D5}, {C3, D5}}, // Position 6 depths 4, 5
+        {{B8, C6}, {B8, C6}}, // Position 7 depths 4, 5
+        {{B4, C3}, {B4, C3}}, // Position 8 depths 4, 5
+        {{H4, G3}, {H4, G3}}, // Position 9 depths 4, 5
+        {{C6, D4}, {C6, D4}}  // Position 10 depths 4, 5
+    };
+
+    int passed = 0;
+    for (int position = 0; position < NUM_SEARCH_POS; ++position)
+    {
+        for (int depth = 0; depth < DEPTH; ++depth)
+        {
+            // Search with a new AI each time, so that no search is helped by the one before it
+            Board newBoard(searchFens[position]);
+            Colors color = newBoard.getFen()->activeColor;
+            ChessAI ai(color, depth + FIRST_DEPTH);
+
+            Logger::disable();
+            Move bestMove = ai.getBestMove(&newBoard, color);
+            Logger::enable();
+
+            if (bestMove.start == results[position][depth][0] && bestMove.end == results[position][depth][1])
+            {
+                Logger::log("Position %i at depth %i PASSED!\n", position + 1, depth + FIRST_DEPTH);
+                ++passed;
+            }
+            else
+            {
+                Logger::log("Position %i at depth %i FAILED - %s%s/%s%s\n", position + 1, depth + FIRST_DEPTH,
+                    Chess::SquareChars[bestMove.start], Chess::SquareChars[bestMove.end],
+                    Chess::SquareChars[results[position][depth][0]], Chess::SquareChars[results[position][depth][1]]);
+            }
+        }
+    }
+    Logger::log("%i/%i searches found the expected move\n", passed, NUM_SEARCH_POS * DEPTH);
+    Logger::restore();
+}
+
+// @purpose: Runs the ChessAI on tactical positions to fixed depths, checking that it finds the only correct move
+//           Used to check that a change to the search or the evaluation does not make it play worse
+// @parameters: None
+// @return: None
+void PerfTest::runTacticsTest()
+{
+    // Every position is solved well within the shallowest depth, so each depth must find the same move
+    const int FIRST_DEPTH = 4;
+    const int DEPTH = 2;
+
+    int passed = 0;
+    for (int position = 0; position < NUM_TACTICAL_POS; ++position)
+    {
+        const TacticalPosition& tactic = tacticalPositions[position];
+        for (int depth = 0; depth < DEPTH; ++depth)
+        {
+            // Search with a new AI each time, so that no search is helped by the one before it
+            Board newBoard(tactic.fen);
+            Colors color = newBoard.getFen()->activeColor;
+            ChessAI ai(color, depth + FIRST_DEPTH);
+
+            Logger::disable();
+            Move bestMove = ai.getBestMove(&newBoard, color);
+            Logger::enable();
+
+            if (bestMove.start == tactic.start && bestMove.end == tactic.end)
+            {
+                Logger::log("Tactic %i at depth %i PASSED!\n", position + 1, depth + FIRST_DEPTH);
+                ++passed;
+            }
+            else
+            {
+                Logger::log("Tactic %i at depth %i FAILED - %s%s/%s%s - %s\n", position + 1, depth + FIRST_DEPTH,
+                    Chess::SquareChars[bestMove.start], Chess::SquareChars[bestMove.end],
+                    Chess::SquareChars[tactic.start], Chess::SquareChars[tactic.end], tactic.description);
+            }
+        }
+    }
+    Logger::log("%i/%i searches found the correct move\n", passed, NUM_TACTICAL_POS * DEPTH);
+    Logger::restore();
+}
+
+// @purpose: Searches the test fens to a fixed depth with each search technique turned off in turn,
+//           to measure what each one saves
+// @parameters: depth to search
+// @return: None
+void PerfTest::runSearchBenchmark(int depth)
+{
+    const int NUM_RUNS = 8;
+    const char* names[NUM_RUNS] =
+    {
+        "All Features",
+        "No Null Move Pruning",
+        "No Late Move Reductions",
+        "No Reverse Futility Pruning",
+        "No Futility Pruning",
+        "No Check Extensions",
+        "No Lazy Evaluation",
+        "No Features"
+    };
+    const int features[NUM_RUNS] =
+    {
+        ChessAI::ALL_SEARCH_FEATURES,
+        ChessAI::ALL_SEARCH_FEATURES & ~ChessAI::NULL_MOVE_PRUNING,
+        ChessAI::ALL_SEARCH_FEATURES & ~ChessAI::LATE_MOVE_REDUCTIONS,
+        ChessAI::ALL_SEARCH_FEATURES & ~ChessAI::REVERSE_FUTILITY_PRUNING,
+        ChessAI::ALL_SEARCH_FEATURES & ~ChessAI::FUTILITY_PRUNING,
+        ChessAI::ALL_SEARCH_FEATURES & ~ChessAI::CHECK_EXTENSIONS,
+        ChessAI::ALL_SEARCH_FEATURES & ~ChessAI::LAZY_EVALUATION,
+        0
+    };
+
+    long long nodes[NUM_RUNS];
+    long long milliseconds[NUM_RUNS];
+
+    for (int run = 0; run < NUM_RUNS; ++run)
+    {
+        nodes[run] = 0;
+        milliseconds[run] = 0;
+
+        for (int position = 0; position < NUM_SEARCH_POS; ++position)
+        {
+            // Search with a new AI each time, so that no search is helped by the one before it
+            Board newBoard(searchFens[position]);
+            Colors color = newBoard.getFen()->activeColor;
+            ChessAI ai(color, depth);
+            ai.setSearchFeatures(features[run]);
+
+            Logger::disable();
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            ai.getBestMove(&newBoard, color);
+            std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+
+            nodes[run] += ai.getNodesSearched();
+            milliseconds[run] += std::chrono::duration_cast<std::chrono::milliseconds>(stop - start).count();
+        }
+    }
+
+    // Print all of the results together, after the output of the searches
+    Logger::enable();
+    Logger::log("Search Benchmark at depth %i\n", depth);
+    for (int run = 0; run < NUM_RUNS; ++run)
+    {
+        long long nodesPerSecond = (milliseconds[run] > 0) ? nodes[run] * 1000 / milliseconds[run] : 0;
+        Logger::log("%-28s %10lld Nodes in %6lld ms - %8lld Nodes/Second\n", names[run], nodes[run], milliseconds[run], nodesPerSecond);
+    }
+    Logger::restore();
+}
+
 // @purpose: Times move genreation and move making to determine efficiency
 // @parameters: None
 // @return: None
 void PerfTest::timeT()
 {
+    // Enough repetitions that the clock's resolution does not matter
+    const int REPETITIONS = 100000;
 
-}
+    long long totalGenerations = 0;
+    long long totalMoves = 0;
+    long long generationNanoseconds = 0;
+    long long moveNanoseconds = 0;
+
+    for (int position = 0; position < NUM_PERFT_POS; ++position)
+    {
+        Logger::disable();
+        Board newBoard(perftFens[position]);
+        Logger::restore();
+        Colors color = newBoard.getFen()->activeColor;
 
+        // Generate the moves of the position over and over - the checks and pins are calculated once and kept
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (int i = 0; i < REPETITIONS; ++i)
+        {
+            newBoard.calculateAllMoves(color);
+        }
+        std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+        long long generation = std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count();
 
+        // Make and undo every move of the position over and over
+        MoveList moves = *newBoard.getAllMoves(color);
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < REPETITIONS; ++i)
+        {
+            for (MoveList::iterator it = moves.begin(); it != moves.end(); ++it)
+            {
+                newBoard.makeMove(*it);
+                newBoard.undoMove();
+            }
+        }
+        stop = std::chrono::steady_clock::now();
+        long long making = std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count();
 
+        Logger::enable();
+        Logger::log("Position %i: %lld ns to generate %i moves, %lld ns to make and undo a move\n", position + 1,
+            generation / REPETITIONS, moves.size(), (moves.size() > 0) ? making / ((long long)REPETITIONS * moves.size()) : 0);
+        Logger::restore();
+
+        totalGenerations += REPETITIONS;
+        totalMoves += (long long)REPETITIONS * moves.size();
+        generationNanoseconds += generation;
+        moveNanoseconds += making;
+    }
+
+    Logger::enable();
+    Logger::log("Average: %lld ns to generate the moves of a position, %lld ns to make and undo a move\n",
+        generationNanoseconds / totalGenerations, (totalMoves > 0) ? moveNanoseconds / totalMoves : 0);
+    Logger::restore();
+}
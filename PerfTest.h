@@ -12,27 +12,101 @@
 #ifndef PERF_TEST_H
 #define PERF_TEST_H
 
+#include "PerftHashTable.h"
+
 // Forward Declaration
 class Board;
 
 class PerfTest
 {
 public:
+    // Depth that the Perft tests run to when one is not given - every Perft position has known results this deep
+    static const int PERFT_DEPTH = 5;
 
-    // @purpose: Runs the PerfT function on all test fen to depth 3 - https://www.chessprogramming.org/Perft
-    // @parameters: None
+    // Number of depths with known results for some of the Perft positions
+    // The deepest need the Perft Hash Table to finish in a reasonable time
+    static const int KNOWN_PERFT_DEPTH = 7;
+
+    // Formats of the machine readable report of the Perft benchmark
+    enum ReportFormats
+    {
+        REPORT_NONE,
+        REPORT_CSV,
+        REPORT_JSON
+    };
+
+    // @purpose: Runs the PerfT function on all test fen, checking the counts against the known results
+    //           https://www.chessprogramming.org/Perft_Results
+    //           Depths without a known result are skipped
+    // @parameters: deepest depth to run, at most KNOWN_PERFT_DEPTH
     // @return: None
-    static void runAllPerft();
+    static void runAllPerft(int maxDepth = PERFT_DEPTH);
+
+    // @purpose: Times perft on the test fens to every depth up to a limit, repeating each run to measure its speed
+    //           The counts are checked against the known results, so that it can gate a change to the move generation
+    // @parameters: deepest depth to run (at most KNOWN_PERFT_DEPTH), times to run each position and depth,
+    //              format of the machine readable report, file to write the report to - the console if null
+    // @return: true if every count matched its known result
+    static bool runPerftBenchmark(int maxDepth, int runs, ReportFormats format = REPORT_NONE, const char* reportFile = 0);
 
     // @purpose: Runs the PerfT function on a given fen
     // @parameters: fen string, depth to run
-    // @return: Number of Nodes
-    static int runPerft(const char* fen, int depth);
+    // @return: Number of Nodes, 0 if the depth is not positive
+    static long long runPerft(const char* fen, int depth);
+
+    // @purpose: Runs the PerfT function on a given fen on several threads, each with its own Board
+    //           The subtrees below the root are shared out between the threads, which steal from each other when they run out
+    // @parameters: fen string, depth to run, number of threads - every hardware thread if 0
+    // @return: Number of Nodes, 0 if the depth is not positive
+    static long long runParallelPerft(const char* fen, int depth, int threads = 0);
+
+    // @purpose: Runs perft on every position of an EPD file on several threads, checking the counts the file expects
+    //           Each line is a fen followed by its expected counts, such as "<fen> ;D1 20 ;D2 400 ;D3 8902"
+    //           A position that fails is narrowed down to the move where its counts first go wrong
+    // @parameters: EPD file, deepest depth to run, number of threads - every hardware thread if 0
+    // @return: true if every count matched
+    static bool runPerftSuite(const char* epdFile, int maxDepth, int threads = 0);
 
     // @purpose: Counts the nodes at a given depth - used to test move generation
     // @parameters: int depth, color to calculate for
     // @return: Number of Nodes
-    static int perft(int depth, Colors color);
+    static long long perft(int depth, Colors color);
+
+    // @purpose: Counts the nodes at a given depth on a given Board - so that several threads can count at once
+    // @parameters: Board to count on, int depth, color to calculate for
+    // @return: Number of Nodes
+    static long long perft(Board* perftBoard, int depth, Colors color);
+
+    // @purpose: Turns on the Perft Hash Table, so that subtrees reached by transposition are only counted once
+    //           Every perft run starts with an empty table
+    // @parameters: Size of the table in megabytes, 0 to turn it off
+    // @return: None
+    static void setPerftHashSize(int megabytes);
+
+    // @purpose: Turns on bulk counting, where a position one ply from the end counts its legal moves
+    //           instead of making and undoing each of them - off to check making and undoing every move
+    // @parameters: true to count in bulk, false to make every move
+    // @return: None
+    static void setBulkCounting(bool enabled);
+
+    // @purpose: Runs the ChessAI on test fens to fixed depths, checking that it still finds the moves of the
+    //           White/Black MiniMax search that Negamax replaced
+    //           Used to check that a change to the search does not change its result
+    // @parameters: None
+    // @return: None
+    static void runSearchTest();
+
+    // @purpose: Runs the ChessAI on tactical positions to fixed depths, checking that it finds the only correct move
+    //           Used to check that a change to the search or the evaluation does not make it play worse
+    // @parameters: None
+    // @return: None
+    static void runTacticsTest();
+
+    // @purpose: Searches the test fens to a fixed depth with each search technique turned off in turn,
+    //           to measure what each one saves
+    // @parameters: depth to search
+    // @return: None
+    static void runSearchBenchmark(int depth);
 
     // @purpose: Times move genreation and move making to determine efficiency
     // @parameters: None
@@ -43,6 +117,44 @@ private:
     // Pointer to a Board for use in perft
     static Board* board;
 
+    // Remembers the node counts of subtrees, shared by every perft thread - 0 when it is off
+    static PerftHashTable* hashTable;
+
+    // Whether the last ply is counted from the number of legal moves, instead of making them
+    static bool bulkCounting;
+
+    // @purpose: Logs how often the Perft Hash Table found a subtree, if it is on
+    // @parameters: None
+    // @return: None
+    static void logPerftHashStats();
+
+    // @purpose: Counts the nodes at a given depth on a given Board, counting the Perft Hash Table lookups it makes
+    // @parameters: Board to count on, int depth, color to calculate for, Lookups of the calling thread
+    // @return: Number of Nodes
+    static long long countNodes(Board* perftBoard, int depth, Colors color, PerftHashTable::Counts& counts);
+
+    // @purpose: Narrows a failing perft down to the move where the counts first go wrong, by comparing the Board
+    //           reached by making moves against a Board built from the same fen at every step down the divide
+    // @parameters: fen string of the failing position, smallest depth that fails
+    // @return: None
+    static void findPerftMismatch(const char* fen, int depth);
+
+    // @purpose: Counts the nodes at a given depth by making every move on a copy of its Board, instead of making and
+    //           undoing moves on one Board - a reference for any state that the Board carries between moves
+    // @parameters: fen string, depth to run
+    // @return: Number of Nodes
+    static long long referencePerft(const char* fen, int depth);
+
+    // @purpose: Counts the nodes at a given depth by making every move on a copy of the Board
+    // @parameters: Board of the position, depth to run
+    // @return: Number of Nodes
+    static long long referencePerft(Board& position, int depth);
+
+    // @purpose: Times one perft run without any output, leaving the Logger as it was
+    // @parameters: fen string, depth to run, Number of Nodes to fill
+    // @return: Time of the run in nanoseconds - only the counting, not setting up the board
+    static long long timePerft(const char* fen, int depth, long long& nodes);
+
     // Default Constructor
     PerfTest();
 
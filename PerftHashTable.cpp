@@ -0,0 +1,145 @@
+//-------------------------------------------------------
+//
+// File: PerftHashTable.cpp
+// Author: Edward Koch
+// Description: Holds the definition of the PerftHashTable Class
+//
+// Revision History
+// Author    Date    Description
+//-------------------------------------------------------
+// E. Koch    10/17/26    Initial Creation of PerftHashTable class
+//-------------------------------------------------------
+#include "PerftHashTable.h"
+
+// Slots are only read and written whole, so no ordering between threads is needed
+static const std::memory_order Relaxed = std::memory_order_relaxed;
+
+// @purpose: Construct a table of a given size
+// @parameters: Size of the table in megabytes
+// @return: None
+PerftHashTable::PerftHashTable(int megabytes)
+    : buckets(0),
+      numBuckets(1),
+      sizeMB((megabytes < 1) ? 1 : megabytes),
+      probes(0),
+      hits(0)
+{
+    size_t bytes = (size_t)sizeMB << 20;
+
+    // Use the largest power of two number of buckets that fits in the size
+    while (numBuckets * 2 * sizeof(Bucket) <= bytes)
+    {
+        numBuckets *= 2;
+    }
+
+    buckets = new Bucket[numBuckets];
+    clear();
+}
+
+// Default Destructor
+PerftHashTable::~PerftHashTable()
+{
+    delete[] buckets;
+}
+
+// @purpose: Removes all entries from the table and resets the counts
+// @parameters: None
+// @return: None
+void PerftHashTable::clear()
+{
+    for (size_t i = 0; i < numBuckets; ++i)
+    {
+        for (int j = 0; j < BucketSize; ++j)
+        {
+            // An empty slot has a depth of 0, which is never looked up
+            buckets[i].slots[j].key.store(0, Relaxed);
+            buckets[i].slots[j].data.store(0, Relaxed);
+        }
+    }
+    probes.store(0, Relaxed);
+    hits.store(0, Relaxed);
+}
+
+// @purpose: Looks up the node count below a position
+// @parameters: Zobrist key of the position, Depth counted, Number of Nodes to fill if the position is found,
+//              Lookups of the calling thread to count this one in
+// @return: true if the position is in the table at that depth, false otherwise
+bool PerftHashTable::probe(ZobristKey key, int depth, long long& nodes, Counts& counts)
+{
+    ++counts.probes;
+
+    Bucket& bucket = buckets[key & (numBuckets - 1)];
+    for (int i = 0; i < BucketSize; ++i)
+    {
+        uint64_t data = bucket.slots[i].data.load(Relaxed);
+        if ((bucket.slots[i].key.load(Relaxed) ^ data) == key && (int)(data >> DepthShift) == depth)
+        {
+            nodes = (long long)(data & NodesMask);
+            ++counts.hits;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// @purpose: Saves the node count below a position
+// @parameters: Zobrist key of the position, Depth counted, Number of Nodes
+// @return: None
+void PerftHashTable::store(ZobristKey key, int depth, long long nodes)
+{
+    Bucket& bucket = buckets[key & (numBuckets - 1)];
+    Slot& deepest = bucket.slots[0];
+    Slot& recent = bucket.slots[1];
+    Slot* replace = &recent;
+
+    // Deeper counts save the most work, so they keep the depth-preferred entry
+    uint64_t deepestData = deepest.data.load(Relaxed);
+    if (depth >= (int)(deepestData >> DepthShift))
+    {
+        // Keep the count that is being pushed out in the always-replace entry
+        if (deepestData != 0)
+        {
+            recent.key.store(deepest.key.load(Relaxed), Relaxed);
+            recent.data.store(deepestData, Relaxed);
+        }
+        replace = &deepest;
+    }
+
+    uint64_t data = ((uint64_t)depth << DepthShift) | ((uint64_t)nodes & NodesMask);
+    replace->key.store(key ^ data, Relaxed);
+    replace->data.store(data, Relaxed);
+}
+
+// @purpose: Get the size of the table
+// @parameters: None
+// @return: Size of the table in megabytes
+int PerftHashTable::getSizeMB()
+{
+    return sizeMB;
+}
+
+// @purpose: Adds the lookups of one thread to the totals of the table
+// @parameters: Lookups counted by the thread
+// @return: None
+void PerftHashTable::addCounts(const Counts& counts)
+{
+    probes.fetch_add(counts.probes, Relaxed);
+    hits.fetch_add(counts.hits, Relaxed);
+}
+
+// @purpose: Get the number of lookups since the table was cleared
+// @parameters: None
+// @return: Number of calls to probe
+uint64_t PerftHashTable::getProbes()
+{
+    return probes.load(Relaxed);
+}
+
+// @purpose: Get the number of lookups that found their position
+// @parameters: None
+// @return: Number of calls to probe that returned true
+uint64_t PerftHashTable::getHits()
+{
+    return hits.load(Relaxed);
+}
@@ -0,0 +1,125 @@
+//-------------------------------------------------------
+//
+// File: PerftHashTable.h
+// Author: Edward Koch
+// Description: Holds the declaration of the PerftHashTable Class
+//              The Perft Hash Table remembers the node count below positions by their Zobrist key and depth,
+//              so that a subtree reached through a different move order does not need to be counted again
+//              https://www.chessprogramming.org/Perft#Hashing
+//              Like the Transposition Table, each bucket has a depth-preferred and an always-replace entry,
+//              and every entry stores its key xor-ed with its data so that all Perft threads can share it without locks
+//              Each thread counts its own lookups and adds them to the table once it is done, so a lookup writes nothing shared
+//
+// Revision History
+// Author    Date    Description
+//-------------------------------------------------------
+// E. Koch    10/17/26    Initial Creation of PerftHashTable class
+//-------------------------------------------------------
+#ifndef PERFT_HASH_TABLE_H
+#define PERFT_HASH_TABLE_H
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "Zobrist.h"
+
+class PerftHashTable
+{
+public:
+    // Size of the table when one is not given
+    static const int DefaultSizeMB = 64;
+
+    // Lookups counted by one thread, to measure how well the table works
+    struct Counts
+    {
+        uint64_t probes;
+        uint64_t hits;
+
+        Counts() : probes(0), hits(0) { ; }
+    };
+
+    // @purpose: Construct a table of a given size
+    // @parameters: Size of the table in megabytes
+    // @return: None
+    PerftHashTable(int megabytes = DefaultSizeMB);
+
+    // Default Destructor
+    ~PerftHashTable();
+
+    // @purpose: Removes all entries from the table and resets the counts
+    // @parameters: None
+    // @return: None
+    void clear();
+
+    // @purpose: Looks up the node count below a position
+    // @parameters: Zobrist key of the position, Depth counted, Number of Nodes to fill if the position is found,
+    //              Lookups of the calling thread to count this one in
+    // @return: true if the position is in the table at that depth, false otherwise
+    bool probe(ZobristKey key, int depth, long long& nodes, Counts& counts);
+
+    // @purpose: Saves the node count below a position
+    // @parameters: Zobrist key of the position, Depth counted, Number of Nodes
+    // @return: None
+    void store(ZobristKey key, int depth, long long nodes);
+
+    // @purpose: Get the size of the table
+    // @parameters: None
+    // @return: Size of the table in megabytes
+    int getSizeMB();
+
+    // @purpose: Adds the lookups of one thread to the totals of the table
+    // @parameters: Lookups counted by the thread
+    // @return: None
+    void addCounts(const Counts& counts);
+
+    // @purpose: Get the number of lookups since the table was cleared
+    // @parameters: None
+    // @return: Number of calls to probe
+    uint64_t getProbes();
+
+    // @purpose: Get the number of lookups that found their position
+    // @parameters: None
+    // @return: Number of calls to probe that returned true
+    uint64_t getHits();
+
+private:
+    // Number of entries in each bucket - the first is depth-preferred, the second is always-replace
+    static const int BucketSize = 2;
+
+    // The node count takes the low bits of the data, and the depth the top bits
+    static const int DepthShift = 56;
+    static const uint64_t NodesMask = ((uint64_t)1 << DepthShift) - 1;
+
+    // One entry as it is stored - relaxed atomics let every thread read and write it, the key check catches any tearing
+    struct Slot
+    {
+        std::atomic<uint64_t> key;
+        std::atomic<uint64_t> data;
+    };
+
+    // Entries that share an index in the table
+    struct Bucket
+    {
+        Slot slots[BucketSize];
+    };
+
+    // Holds all of the buckets
+    Bucket* buckets;
+
+    // Number of buckets, always a power of two so that the index is a mask of the key
+    size_t numBuckets;
+
+    // Size the table was made with
+    int sizeMB;
+
+    // Totals of the lookups added by every thread
+    std::atomic<uint64_t> probes;
+    std::atomic<uint64_t> hits;
+
+    // The table owns its buckets, so it can not be copied
+    PerftHashTable(const PerftHashTable&);
+    PerftHashTable& operator = (const PerftHashTable&);
+};
+
+#endif // PERFT_HASH_TABLE_H
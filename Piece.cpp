@@ -20,9 +20,7 @@ Piece::Piece(char idIn, Colors colorIn, Squares posIn)
       color(colorIn),
       hasMoved(false),
       position(posIn),
-      moves(),
-      protecting(),
-      pinnedPath()
+      pinnedPath(~Bitboards::Empty)
 {
     if (color == WHITE)
     {
@@ -80,43 +78,10 @@ void Piece::setHasMoved(bool moved)
     hasMoved = moved;
 }
 
-// @purpose: Get the move vector of this piece
-// @parameters: None
-// @return: Vector of moves
-mvVector* Piece::getMoves()
-{
-    return &moves;
-}
-
-// @purpose: Checks if an end square is in this pieces set of moves
-// @parameters: Square to move to
-// @return: True if it is a valid ending square, false otherwise
-bool Piece::isSquareInMoves(Squares sq)
-{
-    mvVector::iterator it = moves.begin();
-    for (it = moves.begin(); it != moves.end(); ++it)
-    {
-        if (it->end == sq)
-        {
-            return true;
-        }
-    }
-
-    return false;
-}
-
-// @purpose: Get the squares that this piece is protecting
-// @parameters: None
-// @return: Vector of squares
-sqVector* Piece::getProtecting()
-{
-    return &protecting;
-}
-
 // @purpose: Sets the pinnedPath of this piece
-// @parameters: Vector of squares
+// @parameters: Bitboard of the squares from the King to the pinning piece
 // @return: None
-void Piece::setPin(sqVector pinPath)
+void Piece::setPin(Bitboard pinPath)
 {
     pinnedPath = pinPath;
 }
@@ -126,7 +91,7 @@ void Piece::setPin(sqVector pinPath)
 // @return: None
 void Piece::clearPin()
 {
-    pinnedPath.clear();
+    pinnedPath = ~Bitboards::Empty;
 }
 
 // @purpose: Make a move to a new position
@@ -140,16 +105,19 @@ void Piece::makeMove(Squares newPos)
 }
 
 // @purpose: Prints all possible moves for this piece
-// @parameters: None
+// @parameters: Move list of this piece's color
 // @return: None
-void Piece::printMoves()
+void Piece::printMoves(MoveList* moveList)
 {
 
     Logger::log("%c at %s: ", charId, Chess::SquareChars[position]);
-    mvVector::iterator it = moves.begin();
-    for (it; it != moves.end(); ++it)
+    MoveList::iterator it = moveList->begin();
+    for (it; it != moveList->end(); ++it)
     {
-        Logger::log("%s ", Chess::SquareChars[it->end]);
+        if (it->getStart() == position)
+        {
+            Logger::log("%s ", Chess::SquareChars[it->getEnd()]);
+        }
     }
     Logger::log("\n");
 }
@@ -173,24 +141,17 @@ void Piece::printPiece()
 // @return: true if the move is legal, false otherwise
 bool Piece::isLegalMove(Board* board, Squares potentialMove)
 {
-    // Check if this piece is pinned
-    if (!pinnedPath.empty())
-    {
-        // Search for the potential move in the pinnedPath
-        sqVector::iterator it = std::find(pinnedPath.begin(), pinnedPath.end(), potentialMove);
+    Bitboard target = Bitboards::squareBB(potentialMove);
 
-        // If a potential move will take this piece out of the pinned path, the king would then be in check
-        // This is an illegal move
-        if (it == pinnedPath.end())
-        {
-            return false;
-        }
+    // If a potential move will take this piece out of the pinned path, the king would then be in check
+    // This is an illegal move
+    if ((pinnedPath & target) == 0)
+    {
+        return false;
     }
 
-    // Check if the king is in Check
-    std::vector<sqVector>* checkPaths = board->getCheckPaths(color);
-
-    if (!checkPaths->empty())
+    // Check if a potential move will capture or block every piece checking the king
+    if ((board->getCheckMask(color) & target) == 0)
     {
         // Check for enPassant removal of check
         // If an enemy pawn moved forward 2 to check the king, 
@@ -198,48 +159,21 @@ bool Piece::isLegalMove(Board* board, Squares potentialMove)
         if (type == PAWN &&
             potentialMove == board->getFen()->enPassantTarget)
         {
-            // Iterate through all possible check paths
-            std::vector<sqVector>::iterator it = checkPaths->begin();
-
-            for (it; it != checkPaths->end(); ++it)
-            {
-                // Check if the En Passant Target is the piece checking the king
-                if (abs(it->front() - potentialMove) == Chess::NumFiles)
-                {
-                    return true;
-                }
-            }
+            // The En Passant Pawn is directly behind the target square
+            int captured = (color == WHITE) ? potentialMove + Chess::NumFiles : potentialMove - Chess::NumFiles;
+            return (board->getCheckMask(color) & Bitboards::squareBB(captured)) != 0;
         }
 
-        // Iterate through all possible check paths
-        std::vector<sqVector>::iterator it = checkPaths->begin();
-
-        for (it; it != checkPaths->end(); ++it)
-        {
-            // Check if a potential move will block check
-            sqVector::iterator jt = std::find(it->begin(), it->end(), potentialMove);
-            if (jt == it->end())
-            {
-                // If there is a check path that this move woud not block, return false
-                return false;
-            }
-        }
+        return false;
     }
 
-
     return true;
 }
 
-// @purpose: Creates a Move object and saves it to the potential moves
-// @parameters: Square index to move to
+// @purpose: Creates a Move and saves it to the potential moves
+// @parameters: Move list to add to, Square index to move to, PackedMove flags of the move
 // @return: None
-void Piece::addMove(int potentialMove)
+void Piece::addMove(MoveList& moveList, int potentialMove, int flags)
 {
-    Move move;
-
-    move.pieceMoved = this;
-    move.start = position;
-    move.end = (Squares)potentialMove;
-
-    moves.push_back(move);
+    moveList.add(PackedMove(position, (Squares)potentialMove, flags));
 }
\ No newline at end of file
@@ -15,6 +15,7 @@
 #include "ChessTypes.h"
 #include "Board.h"
 #include "Move.h"
+#include "MoveList.h"
 
 class Piece
 {
@@ -23,7 +24,7 @@ public:
     Piece(char idIn, Colors colorIn, Squares posIn);
 
     // Default Destructor
-    ~Piece();
+    virtual ~Piece();
 
     // @purpose: Get a character representation of this piece
     // @parameters: None
@@ -50,30 +51,15 @@ public:
     // @return: None
     void setHasMoved(bool moved);
 
-    // @purpose: Calculate all possible moves given a character representation of the boad
-    // @parameters: Character Representation of the board, Color of piece that is moving, Color of piece that is moving
+    // @purpose: Calculate all possible moves of this piece
+    // @parameters: Board object to search, Move list to add the moves to
     // @return: None
-    virtual void calculateMoves(Board* board, Colors turn) = 0;
-
-    // @purpose: Get the move vector of this piece
-    // @parameters: None
-    // @return: Vector of moves
-    mvVector* getMoves();
-
-    // @purpose: Checks if an end square is in this pieces set of moves
-    // @parameters: Square to move to
-    // @return: True if it is a valid ending square, false otherwise
-    bool isSquareInMoves(Squares sq);
-
-    // @purpose: Get the squares that this piece is protecting
-    // @parameters: None
-    // @return: Vector of squares
-    sqVector* getProtecting();
+    virtual void calculateMoves(Board* board, MoveList& moveList) = 0;
 
     // @purpose: Sets the pinnedPath of this piece
-    // @parameters: Vector of squares
+    // @parameters: Bitboard of the squares from the King to the pinning piece
     // @return: None
-    void setPin(sqVector pinPath);
+    void setPin(Bitboard pinPath);
 
     // @purpose: Clears the pinnedPath of this piece between each move
     // @parameters: None
@@ -86,9 +72,9 @@ public:
     void makeMove(Squares newPos);
 
     // @purpose: Prints all possible moves for this piece
-    // @parameters: None
+    // @parameters: Move list of this piece's color
     // @return: None
-    void printMoves();
+    void printMoves(MoveList* moveList);
 
     // @purpose: Print the Piece details
     // @parameters: None
@@ -110,22 +96,19 @@ protected:
     // Holds the position of the piece
     Squares position;
 
-    // Holds all current possible moves 
-    mvVector moves;
-    sqVector protecting;
-
     // Holds the path of an attacking piece to the friendly king through this piece(if one exists)
-    sqVector pinnedPath;
+    // Every square is in the path if this piece is not pinned
+    Bitboard pinnedPath;
 
     // @purpose: Checks if a move would take this piece out of a potential pin situation
     // @parameters: Square to move to
     // @return: true if square is in the pin path, false otherwise
     bool isLegalMove(Board* board, Squares potentialMove);
 
-    // @purpose: Creates a Move object and saves it to the potential moves
-    // @parameters: Square index to move to
+    // @purpose: Creates a Move and saves it to the potential moves
+    // @parameters: Move list to add to, Square index to move to, PackedMove flags of the move
     // @return: None
-    void addMove(int potentialMove);
+    void addMove(MoveList& moveList, int potentialMove, int flags = PackedMove::QUIET);
 
 private:
 
@@ -26,24 +26,12 @@ Queen::~Queen()
 
 }
 
-// @purpose: Calculate all possible moves given a character representation of the boad
-// @parameters: Character Representation of the board, Color of piece that is moving
+// @purpose: Calculate all possible moves of this piece
+// @parameters: Board object to search, Move list to add the moves to
 // @return: None
-void Queen::calculateMoves(Board* board, Colors turn)
+void Queen::calculateMoves(Board* board, MoveList& moveList)
 {
-    // Clear the current move vector
-    moves.clear();
-    protecting.clear();
-
     // Calculate moves in all possible directions
-    calculateSlidingMoves(board, UP);
-    calculateSlidingMoves(board, DOWN);
-    calculateSlidingMoves(board, LEFT);
-    calculateSlidingMoves(board, RIGHT);
-    calculateSlidingMoves(board, UP_LEFT);
-    calculateSlidingMoves(board, UP_RIGHT);
-    calculateSlidingMoves(board, DN_LEFT);
-    calculateSlidingMoves(board, DN_RIGHT);
-
+    calculateSlidingMoves(board, moveList);
 }
 
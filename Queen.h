@@ -24,10 +24,10 @@ public:
     // Default Destructor
     ~Queen();
 
-    // @purpose: Calculate all possible moves given a character representation of the boad
-    // @parameters: Character Representation of the board, Color of piece that is moving
+    // @purpose: Calculate all possible moves of this piece
+    // @parameters: Board object to search, Move list to add the moves to
     // @return: None
-    virtual void calculateMoves(Board* board, Colors turn);
+    virtual void calculateMoves(Board* board, MoveList& moveList);
 
 private:
 
@@ -27,21 +27,13 @@ Rook::~Rook()
 
 }
 
-// @purpose: Calculate all possible moves given a character representation of the boad
-// @parameters: Character Representation of the board, Color of piece that is moving
+// @purpose: Calculate all possible moves of this piece
+// @parameters: Board object to search, Move list to add the moves to
 // @return: None
-void Rook::calculateMoves(Board* board, Colors turn)
+void Rook::calculateMoves(Board* board, MoveList& moveList)
 {
-    // Clear the current move vector
-    moves.clear();
-    protecting.clear();
-
     // Calculate moves in all possible directions
-    calculateSlidingMoves(board, UP);
-    calculateSlidingMoves(board, DOWN);
-    calculateSlidingMoves(board, LEFT);
-    calculateSlidingMoves(board, RIGHT);
-
+    calculateSlidingMoves(board, moveList);
 }
 
 
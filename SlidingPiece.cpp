@@ -28,216 +28,53 @@ SlidingPiece::~SlidingPiece()
 {
 }
 
-// @purpose: Calculate all possible sliding moves in one direction
-// @parameters: Character Representation of the board, direction that the piece is going
+// @purpose: Calculate all possible sliding moves using the precomputed attack tables
+// @parameters: Board object to search, Move list to add the moves to
 // @return: None
-void SlidingPiece::calculateSlidingMoves(Board* board, Direction dir)
+void SlidingPiece::calculateSlidingMoves(Board* board, MoveList& moveList)
 {
-    // Determines if this piece is pinning another piece
-    bool potentialPin = false;
-    // The square of the piece who potentially is pinned
-    Squares potentialPinSquare = INVALID;
-    // Path of the attacking piece to the King - 
-    // From the current piece to the enemy king, potentially through a pinned piece
-    sqVector pathToKing;
-    pathToKing.push_back(position);
+    // All squares attacked by this piece, up to and including the first blocker in each direction
+    Bitboard attacks = getSlidingAttacks(position, board->getOccupancy());
 
-    // Get Character Representation of the board
-    const char* charBoard = board->getCharBoard();
-
-    // Determines if a move has wrapped around the board
-    int wrapFile = getWrapFile(dir);
-
-    // Loop through all moves in one direction
-    for (int numSquares = 1; numSquares <= Chess::NumFiles; ++numSquares)
+    // Any attacked square without a friendly piece is a potential move
+    Bitboard enemyPieces = board->getOccupancy(Chess::enemy[color]);
+    Bitboard targets = attacks & ~board->getOccupancy(color);
+    while (targets)
     {
-        int potentialMove = position + (directionValues[dir] * numSquares);
+        Squares potentialMove = Bitboards::popLsb(targets);
 
-        // Do not check moves that are off of the board
-        if (potentialMove < A8 || potentialMove > H1)
-        {
-            // Stop Searching in this direction
-            break;
-        }
-        // Do not check moves that have wrapped around the board
-        else if (potentialMove % Chess::NumFiles == wrapFile)
-        {
-            // Stop Searching in this direction
-            break;
-        }
-        // Check if the square is empty
-        else if (charBoard[potentialMove] == '-')
+        // Check if this would be an otherwise illegal move (Pin/Check/etc)
+        if (isLegalMove(board, potentialMove))
         {
-            // If we have not previously encountered an enemy piece
-            if (!potentialPin)
+            if (enemyPieces & Bitboards::squareBB(potentialMove))
             {
-                // And if this move would be otherwise legal
-                if (isLegalMove(board, (Squares)potentialMove))
-                {
-                    // Add the potential capture to the move vector
-                    addMove(potentialMove);
-                    addDisambiguations(charBoard, moves.back());
-                }
-                // Add the potential move to the protecting vector
-                protecting.push_back((Squares)potentialMove);
+                addMove(moveList, potentialMove, PackedMove::CAPTURE);
             }
-            
-            // All empty squares are potentially in the path to the enemy king
-            pathToKing.push_back((Squares)potentialMove);
-
-        }
-        // Check if there is a friendly Piece in the way
-        else if (isupper(charBoard[potentialMove]) == isupper(charId))
-        {
-            // If we have not previously encountered an enemy piece
-            if (!potentialPin)
+            else
             {
-                // Add the potential move to the protecting vector
-                protecting.push_back((Squares)potentialMove);
+                addMove(moveList, potentialMove);
             }
-
-            // Stop Searching in this direction
-            break;
         }
-        // Check if there is an enemy piece in the way
-        else if (isupper(charBoard[potentialMove]) != isupper(charId))
-        {
-            // If we have not previously encountered an enemy piece
-            if (!potentialPin)
-            {
-                // And if this move would be otherwise legal
-                if (isLegalMove(board, (Squares)potentialMove))
-                {
-                    // Add the potential capture to the move vector
-                    addMove(potentialMove);
-                    addDisambiguations(charBoard, moves.back());
-                }
-
-                // If the enemy piece is not a king, it is potentially 'pinned' to the King
-                if (board->getPieceAt((Squares)potentialMove)->getType() != KING)
-                {
-                    potentialPin = true;
-                    potentialPinSquare = (Squares)potentialMove;
-                }
-                // If there is no pin, and the king is found, then king is in check
-                else
-                {
-                    pathToKing.push_back((Squares)potentialMove);
-                    board->addCheckPath(pathToKing, Chess::enemy[color]);
-                }
-            }
-            // Evaluate a potential pin situation
-            else
-            {
-                // If there is a potential pin and the piece is pinned to a king
-                if (board->getPieceAt((Squares)potentialMove)->getType() == KING)
-                {
-                    board->getPieceAt(potentialPinSquare)->setPin(pathToKing);
-                }
-
-                // Stop Searching in this direction
-                break;
-            }  // !potentialPin  
-        } // piece check
-    } // For Loop
+    }
 }
 
-// @purpose: Get the wrap file for a given direction
-// @parameters: Direction to wrap
-// @return: File index to check against wrapping
-int SlidingPiece::getWrapFile(Direction dir)
+// @purpose: Get the squares this type of sliding piece attacks from a square
+// @parameters: Square to slide from, Bitboard of all occupied squares
+// @return: Bitboard of attacked squares
+Bitboard SlidingPiece::getSlidingAttacks(Squares sq, Bitboard occupied)
 {
-    // Determines if a move has wrapped around the board
-    int wrapFile = 9; // Invalid File
-    // Determines 
-    switch (dir)
+    switch (type)
     {
-        // Up and Down do not wrap around the board
-    case UP:
-    case DOWN:
-        break;
+    case ROOK:
+        return Bitboards::rookAttacks(sq, occupied);
 
-    case LEFT:
-    case UP_LEFT:
-    case DN_LEFT:
-        wrapFile = 7; // H-File - 1 for 0 based indexing
-        break;
+    case BISHOP:
+        return Bitboards::bishopAttacks(sq, occupied);
 
-    case RIGHT:
-    case UP_RIGHT:
-    case DN_RIGHT:
-        wrapFile = 0; // A-File - 1 for 0 based indexing
-        break;
+    case QUEEN:
+        return Bitboards::queenAttacks(sq, occupied);
 
     default:
-        break;
+        return Bitboards::Empty;
     }
-
-    return wrapFile;
 }
-
-
-// @purpose: Check if any other of the same piece could move to the same square
-// @parameters: Char board to search, Move to update
-// @return: None
-void SlidingPiece::addDisambiguations(const char* charBoard, Move& move)
-{
-    // Check in all directions for a potential disambiguating piece
-    for (int dir = 0; dir <= DN_RIGHT; ++dir)
-    {
-        // Only process U, D, L, R moves for Rooks
-        if (dir > RIGHT && type == ROOK) continue;
-
-        // Only process UR, UL, DR, DL moves for Bishops
-        if (dir < UP_LEFT && type == BISHOP) continue;
-
-        // Loop through all squares in that direction
-        // Determines if a move has wrapped around the board
-        int wrapFile = getWrapFile((Direction)dir);
-
-        // Check to the end of the board in each direction
-        for (int numSquares = 1; numSquares <= Chess::NumFiles; ++numSquares)
-        {
-            int potentialDiambiguation = move.end + (directionValues[dir] * numSquares);
-
-            // Do not check moves that are off of the board
-            if (potentialDiambiguation < A8 || potentialDiambiguation > H1)
-            {
-                // Stop Searching in this direction
-                break;
-            }
-            // Do not check moves that have wrapped around the board
-            else if (potentialDiambiguation % Chess::NumFiles == wrapFile)
-            {
-                // Stop Searching in this direction
-                break;
-            }
-            // Do not check the move from the potential move back to where this piece is
-            else if (potentialDiambiguation == position)
-            {
-                continue;
-            }
-            // Check if a piece is encounters (Only the first piece matters for this search)
-            else if (charBoard[potentialDiambiguation] != '-')
-            {
-                // Only check for other pieces of the same color
-                if (charBoard[potentialDiambiguation] == charId)
-                {
-                    // Check if the other piece is on a different file
-                    if (potentialDiambiguation % Chess::NumFiles !=
-                        move.start % Chess::NumFiles)
-                    {
-                        move.fileDisambig = Chess::File[move.start % Chess::NumFiles];
-                    }
-                    // Check if the other piece is on a different rank
-                    else if (potentialDiambiguation / Chess::NumRanks !=
-                        move.start / Chess::NumRanks)
-                    {
-                        move.rankDisambig = Chess::Rank[move.start / Chess::NumRanks];
-                    }
-                }
-                break;
-            }
-        } // Squares in Direction
-    } // Directions
-}
\ No newline at end of file
@@ -29,47 +29,17 @@ public:
     ~SlidingPiece();
 
 protected:
-    enum Direction
-    {
-        UP,
-        DOWN,
-        LEFT,
-        RIGHT,
-        UP_LEFT,
-        UP_RIGHT,
-        DN_LEFT,
-        DN_RIGHT
-    };
-
-    // The difference in board index coresponding to each direciton
-    const int directionValues[DN_RIGHT + 1] =
-    {
-        -8, // Up
-        8,  // Down
-        -1, // Left
-        1,  // Right
-        -9, // Up Left
-        -7, // Up Right
-        7,  // Down Left
-        9   // Down Right
-    };
-
-    // @purpose: Calculate all possible sliding moves in one direction
-    // @parameters: Character Representation of the board, direction that the piece is going
+    // @purpose: Calculate all possible sliding moves using the precomputed attack tables
+    // @parameters: Board object to search, Move list to add the moves to
     // @return: None
-    void calculateSlidingMoves(Board* board, Direction dir);
+    void calculateSlidingMoves(Board* board, MoveList& moveList);
 
 private:
 
-    // @purpose: Get the wrap file for a given direction
-    // @parameters: Direction to wrap
-    // @return: File index to check against wrapping
-    int getWrapFile(Direction dir);
-
-    // @purpose: Check if any other of the same piece could move to the same square
-    // @parameters: Char board to search, Move to update
-    // @return: None
-    void addDisambiguations(const char* charBoard, Move& move);
+    // @purpose: Get the squares this type of sliding piece attacks from a square
+    // @parameters: Square to slide from, Bitboard of all occupied squares
+    // @return: Bitboard of attacked squares
+    Bitboard getSlidingAttacks(Squares sq, Bitboard occupied);
 };
 
 #endif // SLIDING_PIECE_H
\ No newline at end of file
@@ -0,0 +1,181 @@
+//-------------------------------------------------------
+//
+// File: TranspositionTable.cpp
+// Author: Edward Koch
+// Description: Holds the definition of the TranspositionTable Class
+//
+// Revision History
+// Author    Date    Description
+//-------------------------------------------------------
+// E. Koch    10/17/26    Initial Creation of TranspositionTable class
+//-------------------------------------------------------
+#include "TranspositionTable.h"
+
+// Slots are only read and written whole, so no ordering between threads is needed
+static const std::memory_order Relaxed = std::memory_order_relaxed;
+
+// @purpose: Construct a table of a given size
+// @parameters: Size of the table in megabytes
+// @return: None
+TranspositionTable::TranspositionTable(int megabytes)
+    : buckets(0),
+      numBuckets(0),
+      generation(0)
+{
+    resize(megabytes);
+}
+
+// Default Destructor
+TranspositionTable::~TranspositionTable()
+{
+    delete[] buckets;
+}
+
+// @purpose: Resizes the table, removing all entries
+// @parameters: Size of the table in megabytes, rounded down to a power of two number of buckets
+// @return: None
+void TranspositionTable::resize(int megabytes)
+{
+    size_t bytes = (size_t)((megabytes < 1) ? 1 : megabytes) << 20;
+
+    // Use the largest power of two number of buckets that fits in the size
+    size_t count = 1;
+    while (count * 2 * sizeof(Bucket) <= bytes)
+    {
+        count *= 2;
+    }
+
+    if (count != numBuckets)
+    {
+        delete[] buckets;
+        buckets = new Bucket[count];
+        numBuckets = count;
+    }
+
+    clear();
+}
+
+// @purpose: Removes all entries from the table
+// @parameters: None
+// @return: None
+void TranspositionTable::clear()
+{
+    for (size_t i = 0; i < numBuckets; ++i)
+    {
+        for (int j = 0; j < BucketSize; ++j)
+        {
+            buckets[i].slots[j].key.store(0, Relaxed);
+            buckets[i].slots[j].data.store(0, Relaxed);
+        }
+    }
+    generation = 0;
+}
+
+// @purpose: Marks the start of a new search, so that entries from older searches are replaced first
+// @parameters: None
+// @return: None
+void TranspositionTable::newSearch()
+{
+    // The generation only has 6 bits in an entry
+    generation = (generation + 1) & 0x3F;
+}
+
+// @purpose: Looks up a position in the table
+// @parameters: Zobrist key of the position, Entry to fill if the position is found
+// @return: true if the position is in the table, false otherwise
+bool TranspositionTable::probe(ZobristKey key, Entry& entry)
+{
+    Bucket& bucket = getBucket(key);
+
+    for (int i = 0; i < BucketSize; ++i)
+    {
+        uint64_t data = bucket.slots[i].data.load(Relaxed);
+        if ((bucket.slots[i].key.load(Relaxed) ^ data) == key)
+        {
+            unpack(data, entry);
+            if (entry.bound != BOUND_NONE)
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+// @purpose: Saves the result of searching a position
+// @parameters: Zobrist key of the position, Depth searched, Score, Bound of the score, Best move found
+// @return: None
+void TranspositionTable::store(ZobristKey key, int depth, int score, Bounds bound, PackedMove move)
+{
+    Bucket& bucket = getBucket(key);
+    Slot& deepest = bucket.slots[0];
+    Slot& recent = bucket.slots[1];
+    Slot* replace = &recent;
+
+    uint64_t deepestData = deepest.data.load(Relaxed);
+    ZobristKey deepestKey = deepest.key.load(Relaxed) ^ deepestData;
+    Entry deepestEntry;
+    unpack(deepestData, deepestEntry);
+
+    // The depth-preferred entry is replaced by the same position, a deeper search, or anything newer than it
+    if (deepestKey == key ||
+        deepestEntry.bound == BOUND_NONE ||
+        deepestEntry.generation != generation ||
+        depth >= deepestEntry.depth)
+    {
+        // Keep the result that is being pushed out in the always-replace entry
+        if (deepestKey != key && deepestEntry.bound != BOUND_NONE)
+        {
+            recent.key.store(deepestKey ^ deepestData, Relaxed);
+            recent.data.store(deepestData, Relaxed);
+        }
+        replace = &deepest;
+    }
+
+    // Keep the previous best move of the position if this search did not find one
+    uint64_t oldData = replace->data.load(Relaxed);
+    if (move.isNull() && (replace->key.load(Relaxed) ^ oldData) == key)
+    {
+        Entry oldEntry;
+        unpack(oldData, oldEntry);
+        move = oldEntry.move;
+    }
+
+    uint64_t data = pack(depth, score, bound, move, generation);
+    replace->key.store(key ^ data, Relaxed);
+    replace->data.store(data, Relaxed);
+}
+
+// @purpose: Get the size of the table
+// @parameters: None
+// @return: Number of entries the table can hold
+size_t TranspositionTable::getNumEntries()
+{
+    return numBuckets * BucketSize;
+}
+
+// @purpose: Packs the result of a search into the data of a slot
+// @parameters: Depth searched, Score, Bound of the score, Best move found, Generation of the search
+// @return: Packed data
+uint64_t TranspositionTable::pack(int depth, int score, Bounds bound, PackedMove move, int generation)
+{
+    // Bits 0-31 are the score, 32-47 the move, 48-55 the depth, 56-57 the bound, and 58-63 the generation
+    return (uint64_t)(uint32_t)score |
+           ((uint64_t)move.getData() << 32) |
+           ((uint64_t)(uint8_t)depth << 48) |
+           ((uint64_t)bound << 56) |
+           ((uint64_t)generation << 58);
+}
+
+// @purpose: Unpacks the data of a slot
+// @parameters: Packed data, Entry to fill
+// @return: None
+void TranspositionTable::unpack(uint64_t data, Entry& entry)
+{
+    entry.score = (int32_t)(uint32_t)data;
+    entry.move = PackedMove((uint16_t)(data >> 32));
+    entry.depth = (int8_t)(uint8_t)(data >> 48);
+    entry.bound = (Bounds)((data >> 56) & 0x3);
+    entry.generation = (int)(data >> 58);
+}
@@ -0,0 +1,142 @@
+//-------------------------------------------------------
+//
+// File: TranspositionTable.h
+// Author: Edward Koch
+// Description: Holds the declaration of the TranspositionTable Class
+//              The Transposition Table remembers the result of searched positions by their Zobrist key,
+//              so that a position reached through a different move order does not need to be searched again
+//              The table has a power of two number of buckets, each with a depth-preferred entry
+//              and an always-replace entry - https://www.chessprogramming.org/Transposition_Table
+//              The table is shared by all search threads without locks - each entry stores its key
+//              xor-ed with its data, so an entry torn by two threads writing at once no longer
+//              matches its key and is ignored - https://www.chessprogramming.org/Shared_Hash_Table#Lockless
+//
+// Revision History
+// Author    Date    Description
+//-------------------------------------------------------
+// E. Koch    10/17/26    Initial Creation of TranspositionTable class
+//-------------------------------------------------------
+#ifndef TRANSPOSITION_TABLE_H
+#define TRANSPOSITION_TABLE_H
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "PackedMove.h"
+#include "Zobrist.h"
+
+class TranspositionTable
+{
+public:
+    // Size of the table when one is not given
+    static const int DefaultSizeMB = 32;
+
+    // How the stored score relates to the true score of the position
+    enum Bounds
+    {
+        BOUND_NONE = 0,
+        BOUND_UPPER = 1, // The search failed low, the true score is at most the stored score
+        BOUND_LOWER = 2, // The search failed high, the true score is at least the stored score
+        BOUND_EXACT = 3  // The true score
+    };
+
+    // The result of searching one position
+    struct Entry
+    {
+        int score;
+        PackedMove move;
+        int depth;
+        Bounds bound;
+        int generation;
+    };
+
+    // @purpose: Construct a table of a given size
+    // @parameters: Size of the table in megabytes
+    // @return: None
+    TranspositionTable(int megabytes = DefaultSizeMB);
+
+    // Default Destructor
+    ~TranspositionTable();
+
+    // @purpose: Resizes the table, removing all entries
+    // @parameters: Size of the table in megabytes, rounded down to a power of two number of buckets
+    // @return: None
+    void resize(int megabytes);
+
+    // @purpose: Removes all entries from the table
+    // @parameters: None
+    // @return: None
+    void clear();
+
+    // @purpose: Marks the start of a new search, so that entries from older searches are replaced first
+    // @parameters: None
+    // @return: None
+    void newSearch();
+
+    // @purpose: Looks up a position in the table
+    // @parameters: Zobrist key of the position, Entry to fill if the position is found
+    // @return: true if the position is in the table, false otherwise
+    bool probe(ZobristKey key, Entry& entry);
+
+    // @purpose: Saves the result of searching a position
+    // @parameters: Zobrist key of the position, Depth searched, Score, Bound of the score, Best move found
+    // @return: None
+    void store(ZobristKey key, int depth, int score, Bounds bound, PackedMove move);
+
+    // @purpose: Get the size of the table
+    // @parameters: None
+    // @return: Number of entries the table can hold
+    size_t getNumEntries();
+
+private:
+    // Number of entries in each bucket - the first is depth-preferred, the second is always-replace
+    static const int BucketSize = 2;
+
+    // One entry as it is stored - the data packs the score, move, depth, bound and generation into 64 bits
+    // Relaxed atomics let every thread read and write the entry, the key check catches any tearing
+    struct Slot
+    {
+        std::atomic<uint64_t> key;
+        std::atomic<uint64_t> data;
+    };
+
+    // Entries that share an index in the table
+    struct Bucket
+    {
+        Slot slots[BucketSize];
+    };
+
+    // Holds all of the buckets
+    Bucket* buckets;
+
+    // Number of buckets, always a power of two so that the index is a mask of the key
+    size_t numBuckets;
+
+    // Counts the searches, to tell which entries are from an older search
+    uint8_t generation;
+
+    // @purpose: Get the bucket that a position maps to
+    // @parameters: Zobrist key of the position
+    // @return: Bucket of the position
+    inline Bucket& getBucket(ZobristKey key)
+    {
+        return buckets[key & (numBuckets - 1)];
+    }
+
+    // @purpose: Packs the result of a search into the data of a slot
+    // @parameters: Depth searched, Score, Bound of the score, Best move found, Generation of the search
+    // @return: Packed data
+    static uint64_t pack(int depth, int score, Bounds bound, PackedMove move, int generation);
+
+    // @purpose: Unpacks the data of a slot
+    // @parameters: Packed data, Entry to fill
+    // @return: None
+    static void unpack(uint64_t data, Entry& entry);
+
+    // The table owns its buckets, so it can not be copied
+    TranspositionTable(const TranspositionTable&);
+    TranspositionTable& operator = (const TranspositionTable&);
+};
+
+#endif // TRANSPOSITION_TABLE_H
@@ -0,0 +1,68 @@
+//-------------------------------------------------------
+//
+// File: Zobrist.cpp
+// Author: Edward Koch
+// Description: Holds the definition of the Zobrist Class
+//
+// Revision History
+// Author    Date    Description
+//-------------------------------------------------------
+// E. Koch    10/17/26    Initial Creation of Zobrist class
+//-------------------------------------------------------
+#include "Zobrist.h"
+
+ZobristKey Zobrist::PieceKeys[BLACK + 1][NUM_PIECES][Chess::NumSquares] = { { { 0 } } };
+ZobristKey Zobrist::CastlingKeys[NUM_CASTLING_RIGHTS] = { 0 };
+ZobristKey Zobrist::EnPassantKeys[Chess::NumFiles] = { 0 };
+ZobristKey Zobrist::SideKey = 0;
+
+bool Zobrist::initialized = false;
+
+// @purpose: Generates all of the random keys - only runs once
+// @parameters: None
+// @return: None
+void Zobrist::init()
+{
+    if (initialized) return;
+
+    // Fixed seed, so that the same keys are generated every run
+    uint64_t seed = 1070372;
+
+    for (int color = WHITE; color <= BLACK; ++color)
+    {
+        for (int type = PAWN; type < NUM_PIECES; ++type)
+        {
+            for (int sq = A8; sq <= H1; ++sq)
+            {
+                PieceKeys[color][type][sq] = random(seed);
+            }
+        }
+    }
+
+    // No castling rights hash to 0, so that a position without them only depends on the pieces
+    for (int rights = 1; rights < NUM_CASTLING_RIGHTS; ++rights)
+    {
+        CastlingKeys[rights] = random(seed);
+    }
+
+    for (int file = 0; file < Chess::NumFiles; ++file)
+    {
+        EnPassantKeys[file] = random(seed);
+    }
+
+    SideKey = random(seed);
+
+    initialized = true;
+}
+
+// @purpose: Generates the next pseudo-random key
+// @parameters: Seed of the generator, updated on every call
+// @return: Random 64-bit key
+ZobristKey Zobrist::random(uint64_t& seed)
+{
+    // xorshift64* random number generator
+    seed ^= seed >> 12;
+    seed ^= seed << 25;
+    seed ^= seed >> 27;
+    return seed * 2685821657736338717ULL;
+}
@@ -0,0 +1,98 @@
+//-------------------------------------------------------
+//
+// File: Zobrist.h
+// Author: Edward Koch
+// Description: Holds the declaration of the Zobrist Class
+//              Zobrist keys hash a position into 64 bits by xor-ing a random key
+//              for every piece on its square, the castling rights, the En Passant file,
+//              and the side to move - https://www.chessprogramming.org/Zobrist_Hashing
+//              Each part can be xor-ed in and out as a move changes it
+//
+// Revision History
+// Author    Date    Description
+//-------------------------------------------------------
+// E. Koch    10/17/26    Initial Creation of Zobrist class
+//-------------------------------------------------------
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include <stdint.h>
+
+#include "ChessTypes.h"
+
+// A 64-bit hash of a position
+typedef uint64_t ZobristKey;
+
+class Zobrist
+{
+public:
+    // Bits of each castling right, combined to index the castling keys
+    enum CastlingRights
+    {
+        WHITE_KING_SIDE = 1,
+        WHITE_QUEEN_SIDE = 2,
+        BLACK_KING_SIDE = 4,
+        BLACK_QUEEN_SIDE = 8,
+        NUM_CASTLING_RIGHTS = 16
+    };
+
+    // @purpose: Generates all of the random keys - only runs once
+    // @parameters: None
+    // @return: None
+    static void init();
+
+    // @purpose: Get the key of a piece on a square
+    // @parameters: Color of the piece, Type of the piece, Square of the piece
+    // @return: Key of the piece
+    static inline ZobristKey piece(Colors color, PieceTypes type, Squares sq)
+    {
+        return PieceKeys[color][type][sq];
+    }
+
+    // @purpose: Get the key of a set of castling rights
+    // @parameters: CastlingRights bits that are available
+    // @return: Key of the castling rights
+    static inline ZobristKey castling(int rights)
+    {
+        return CastlingKeys[rights];
+    }
+
+    // @purpose: Get the key of an En Passant target square
+    // @parameters: En Passant target, INVALID if there is none
+    // @return: Key of the En Passant file, 0 if there is no target
+    static inline ZobristKey enPassant(Squares sq)
+    {
+        return (sq == INVALID) ? 0 : EnPassantKeys[sq % Chess::NumFiles];
+    }
+
+    // @purpose: Get the key that is xor-ed in when Black is to move
+    // @parameters: None
+    // @return: Key of the side to move
+    static inline ZobristKey side()
+    {
+        return SideKey;
+    }
+
+private:
+    // Random keys for every part of a position
+    static ZobristKey PieceKeys[BLACK + 1][NUM_PIECES][Chess::NumSquares];
+    static ZobristKey CastlingKeys[NUM_CASTLING_RIGHTS];
+    static ZobristKey EnPassantKeys[Chess::NumFiles];
+    static ZobristKey SideKey;
+
+    // Determines if the keys have been generated
+    static bool initialized;
+
+    // @purpose: Generates the next pseudo-random key
+    // @parameters: Seed of the generator, updated on every call
+    // @return: Random 64-bit key
+    static ZobristKey random(uint64_t& seed);
+
+    // Default Constructor
+    Zobrist();
+
+    // Default Destructor
+    ~Zobrist();
+};
+
+#endif // ZOBRIST_H
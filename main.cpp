@@ -23,9 +23,34 @@ int main()
     //PerfTest::runAllPerft();
     //return 0;
 
+    // Run the Perft tests to every known depth, only counting transposed subtrees once
+    //PerfTest::setPerftHashSize(256);
+    //PerfTest::runAllPerft(PerfTest::KNOWN_PERFT_DEPTH);
+    //return 0;
+
+    // Benchmark the move generation, failing if any count is wrong
+    // Bulk counting skips making the last ply of moves, for a faster check of only the move generation
+    //PerfTest::setBulkCounting(true);
+    //return PerfTest::runPerftBenchmark(5, 5, PerfTest::REPORT_CSV, "perft.csv") ? 0 : 1;
+    //PerfTest::timeT();
+    //return 0;
+
+    // Check that the search still finds the same moves and solves the tactics, and measure the selective search
+    //PerfTest::runSearchTest();
+    //PerfTest::runTacticsTest();
+    //PerfTest::runSearchBenchmark(6);
+    //return 0;
+
     //const char* fen = "8/2p5/3p3r/KP6/5p1k/8/4P1P1/R7 b - - 3 2";
     //PerfTest::runPerft(fen, 2);
 
+    // Check the move generation against a suite of positions, narrowing down any that fail to a single move
+    //return PerfTest::runPerftSuite("perftsuite.epd", 6) ? 0 : 1;
+
+    // Divide a deep perft across every hardware thread
+    //PerfTest::runParallelPerft(Chess::startingFen, 6);
+    //return 0;
+
     // Play Chess
     Game game;
     //game.setFen(fen);